@@ -0,0 +1,546 @@
+// bench.cpp
+// Part of the Modular Mooch Wolfram module (VCV Rack)
+//
+// GitHub: https://github.com/WesDaMooch/Modular-Mooch-VCV
+//
+// Copyright (c) 2026 Wesley Lawrence Leggo-Morrell
+// License: GPL-3.0-or-later
+
+// Standalone timings for the engine and DSP hot paths, built
+// against the Rack API shim in bench/shim, see bench/Makefile.
+// Times are the best of several runs, in ns per call
+
+#include "../src/Wolfram/wolfEngine.hpp"
+#include "../src/Wolfram/lifeEngine.hpp"
+#include "../src/Wolfram/generationsEngine.hpp"
+#include "../src/Wolfram/volumeEngine.hpp"
+#include "../src/Wolfram/engineList.hpp"
+#include "../src/Wolfram/lifeRule.hpp"
+#include "../src/Wolfram/quantiser.hpp"
+#include "../src/Wolfram/expanderMessage.hpp"
+#include "../src/Wolfram/decimator.hpp"
+#include "../src/Wolfram/outputFx.hpp"
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+Plugin* pluginInstance = nullptr;
+
+using BenchEngines = EngineList<WolfEngine, LifeEngine, GenerationsEngine, VolumeEngine>;
+
+// Keeps results alive so the timed loops are not optimised out
+static volatile float sink = 0.f;
+
+template <typename F>
+static double timeNs(int calls, F&& f) {
+	// Best of nine runs, ns per call
+	double best = 1e30;
+	for (int run = 0; run < 9; run++) {
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < calls; i++)
+			f(i);
+		auto end = std::chrono::steady_clock::now();
+		double ns = std::chrono::duration<double, std::nano>(end - start).count() / calls;
+		best = std::min(best, ns);
+	}
+	return best;
+}
+
+static void benchOversample() {
+	// One output sample of the module's oversampled path: the engine and
+	// output FX once per sub step, then the decimator, as in Wolfram::process().
+	// The engine steps every 64 sub steps, roughly a 700 Hz trigger at 8x
+	std::printf("Oversampling, Wolf engine, ns per output sample\n");
+	for (int fx : { (int)OutputFx::GAIN, (int)OutputFx::SLEW }) {
+		for (int factorIndex = 0; factorIndex < NUM_OVERSAMPLE_FACTORS; factorIndex++) {
+			int factor = oversampleFactors[factorIndex];
+			WolfEngine engine;
+			EngineCoreParams params;
+			params.length = 8;
+			EngineOutput out;
+			OutputFx outputFx;
+			outputFx.setEffect(fx);
+			outputFx.setAmount(0, 0.75f, 48000.f * factor, true);
+			outputFx.setAmount(1, 0.75f, 48000.f * factor, true);
+			PolyphaseDecimator decimator[2];
+			decimator[0].setFactor(factorIndex);
+			decimator[1].setFactor(factorIndex);
+			std::array<std::array<float, MAX_OVERSAMPLE>, 2> buffer{};
+			int subStep = 0;
+
+			double ns = timeNs(1 << 18, [&](int) {
+				for (int i = 0; i < factor; i++) {
+					params.step = (++subStep & 63) == 0;
+					engine.process(params, out);
+					float io[2] = { out.x, out.y };
+					outputFx.process(io);
+					buffer[0][i] = io[0];
+					buffer[1][i] = io[1];
+				}
+				sink = sink + decimator[0].process(buffer[0].data()) + decimator[1].process(buffer[1].data());
+			});
+			std::printf("  %s %dx: %7.1f ns (%.2f%% of a 48 kHz sample)\n",
+				OutputFx::effectLabel[fx], factor, ns, ns * 100.0 / (1e9 / 48000.0));
+		}
+	}
+}
+
+static void benchLifeWorld() {
+	// One Life generation per call at every world size, wrapped, B3/S23.
+	// A fresh random world is dense, after 2000 steps it has settled
+	std::printf("Life large world, ns per step\n");
+	for (int sizeIndex = 0; sizeIndex < LifeEngine::NUM_WORLD_SIZES; sizeIndex++) {
+		for (int settle : { 0, 2000 }) {
+			LifeEngine engine;
+			engine.setWorldSize(sizeIndex);
+			engine.setMode(1);
+			engine.setSeed(9);
+			EngineCoreParams params;
+			params.length = 64;
+			params.probability = 1.f;
+			params.sync = false;
+			EngineOutput out;
+
+			// A reset while generating seeds the world
+			params.reset = true;
+			engine.process(params, out);
+			params.reset = false;
+			params.step = true;
+			for (int i = 0; i < settle; i++)
+				engine.process(params, out);
+
+			// Each run steps on from the last, so fresh worlds are only timed briefly
+			int calls = settle ? 1 << 14 : 64;
+			double ns = timeNs(calls, [&](int) {
+				engine.process(params, out);
+				sink = sink + out.x;
+			});
+			int size = LifeEngine::worldSizes[sizeIndex];
+			std::printf("  %2dx%-2d %s: %7.1f ns\n", size, size, settle ? "settled" : "random ", ns);
+		}
+	}
+}
+
+static void benchDispatch() {
+	// One engine call per sample through the virtual AlgoEngine interface,
+	// as before, and through EngineList::visit, as Wolfram::process() does.
+	// The index is read from a volatile so neither call can be devirtualised
+	// or hoisted. The engines step every 64 samples
+	std::printf("Engine dispatch, ns per sample\n");
+	using Engines = BenchEngines;
+	static Engines engines;
+	std::array<AlgoEngine*, Engines::size> pointers = engines.getPointers();
+	std::vector<std::string> names = Engines::getMenuNames();
+	static volatile int engineIndex = 0;
+
+	for (int index = 0; index < Engines::size; index++) {
+		engineIndex = index;
+		EngineCoreParams params;
+		params.length = 8;
+		EngineOutput out;
+		int sample = 0;
+
+		double virtualNs = timeNs(1 << 20, [&](int) {
+			params.step = (++sample & 63) == 0;
+			pointers[engineIndex]->process(params, out);
+			sink = sink + out.x;
+		});
+		double staticNs = timeNs(1 << 20, [&](int) {
+			params.step = (++sample & 63) == 0;
+			engines.visit(engineIndex, [&](auto& engine) {
+				engine.process(params, out);
+			});
+			sink = sink + out.x;
+		});
+		std::printf("  %-12s virtual: %5.2f ns, static: %5.2f ns\n",
+			names[index].c_str(), virtualNs, staticNs);
+	}
+}
+
+// The Wolfram module's members before and after the hot/cold split, in
+// declaration order, so the two layouts can be timed side by side.
+// inputVoltages stands in for Rack's Module base. Keep these in step
+// with src/Wolfram.cpp when members are added or moved
+struct UnsplitWolframLayout {
+	std::array<float, 9> inputVoltages{};
+	BenchEngines engines;
+	std::array<AlgoEngine*, BenchEngines::size> engine = engines.getPointers();
+	std::array<EngineCoreParams, BenchEngines::size> engineCoreParams{};
+	std::array<EngineMenuParams, BenchEngines::size> engineMenuParams{};
+	int engineSelect = 0;
+	float syncedEngineCv = 0;
+	int engineIndex = 0;
+	std::array<EngineToUiLayer, BenchEngines::size> engineToUiLayerA{};
+	std::array<EngineToUiLayer, BenchEngines::size> engineToUiLayerB{};
+	std::atomic<EngineToUiLayer*> engineToUiLayerPtr{ engineToUiLayerA.data() };
+	int pageCounter = 0;
+	int pageNumber = 0;
+	bool menuActive = false;
+	int displayStyleIndex = 0;
+	int cellStyleIndex = 0;
+	int displayTransformIndex = 0;
+	int displayRoll = 0;
+	bool miniMenuActive = false;
+	bool uiFlip = false;
+	float prevEncoderValue = 0.f;
+	bool encoderReset = false;
+	std::array<size_t, 9> sequenceLengths{ 2, 3, 4, 6, 8, 12, 16, 32, 64 };
+	std::array<size_t, 9> longSequenceLengths{ 128, 256, 512, 1024, 2048, 4096, 8192, 16384, 65536 };
+	bool longLengths = false;
+	size_t sequenceLength = 8;
+	std::array<size_t, 14> playheadDelays{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 24, 32, 48 };
+	int numPlayheads = 0;
+	std::array<int, MAX_PLAYHEADS> playheadLengthIndex{};
+	std::array<int, MAX_PLAYHEADS> playheadDelayIndex{};
+	int wolfWorldIndex = 0;
+	bool wolfReversible = false;
+	int lifeWorldIndex = 0;
+	std::string lifeCustomRule;
+	LifeRule lifeCustomRuleCompiled;
+	bool lifeCustomRulePending = false;
+	int lifeRuleB = LifeEngine::ruleBDefault;
+	int lifeRuleMaskIndex = LifeEngine::RULE_MASK_OFF;
+	int lifeInjectIndex = 0;
+	int fxIndex = OutputFx::SLEW;
+	int quantiserOutputs = Quantiser::OUTPUTS_X;
+	int quantiserScale = 0;
+	int quantiserRoot = 0;
+	int quantiserRange = 1;
+	bool sync = false;
+	bool cellProbability = false;
+	bool audioRateMode = false;
+	int oversampleIndex = 0;
+	int activeOversampleIndex = 0;
+	bool ruleModulation = false;
+	bool engineModulation = false;
+	float prevStepVoltage = 0.f;
+	int srate = 48000;
+	rack::dsp::PulseGenerator xPulse, yPulse;
+	rack::dsp::SchmittTrigger trigTrigger, resetTrigger, posInjectTrigger, negInjectTrigger;
+	rack::dsp::BooleanTrigger menuTrigger, modeTrigger;
+	rack::dsp::Timer ruleDisplayTimer;
+	rack::dsp::RCFilter dcFilter[2];
+	OutputFx outputFx;
+	Quantiser quantiser;
+	PolyphaseDecimator decimator[2];
+	std::array<std::array<float, MAX_OVERSAMPLE>, 2> oversampleBuffer{};
+	std::array<std::array<int, 3>, 64> uiCommands{};
+	std::array<ExpanderToWolframMessage, 2> rightMessages{};
+};
+
+struct SplitWolframLayout {
+	static constexpr size_t CACHE_LINE = 64;
+	std::array<float, 9> inputVoltages{};
+	alignas(CACHE_LINE) std::array<EngineCoreParams, BenchEngines::size> engineCoreParams{};
+	std::array<EngineMenuParams, BenchEngines::size> engineMenuParams{};
+	int engineIndex = 0;
+	float syncedEngineCv = 0;
+	size_t sequenceLength = 8;
+	int activeOversampleIndex = 0;
+	int srate = 48000;
+	float prevStepVoltage = 0.f;
+	float prevEncoderValue = 0.f;
+	bool encoderReset = false;
+	int pageCounter = 0;
+	int pageNumber = 0;
+	bool menuActive = false;
+	bool miniMenuActive = false;
+	bool uiFlip = false;
+	rack::dsp::PulseGenerator xPulse, yPulse;
+	rack::dsp::SchmittTrigger trigTrigger, resetTrigger, posInjectTrigger, negInjectTrigger;
+	rack::dsp::BooleanTrigger menuTrigger, modeTrigger;
+	rack::dsp::Timer ruleDisplayTimer;
+	rack::dsp::RCFilter dcFilter[2];
+	std::array<std::array<float, MAX_OVERSAMPLE>, 2> oversampleBuffer{};
+	OutputFx outputFx;
+	Quantiser quantiser;
+	PolyphaseDecimator decimator[2];
+	std::array<ExpanderToWolframMessage, 2> rightMessages{};
+	alignas(CACHE_LINE) std::array<EngineToUiLayer, BenchEngines::size> engineToUiLayerA{};
+	alignas(CACHE_LINE) std::array<EngineToUiLayer, BenchEngines::size> engineToUiLayerB{};
+	alignas(CACHE_LINE) std::atomic<EngineToUiLayer*> engineToUiLayerPtr{ engineToUiLayerA.data() };
+	alignas(CACHE_LINE) int engineSelect = 0;
+	int displayStyleIndex = 0;
+	int cellStyleIndex = 0;
+	int displayTransformIndex = 0;
+	int displayRoll = 0;
+	bool longLengths = false;
+	int numPlayheads = 0;
+	std::array<int, MAX_PLAYHEADS> playheadLengthIndex{};
+	std::array<int, MAX_PLAYHEADS> playheadDelayIndex{};
+	int wolfWorldIndex = 0;
+	bool wolfReversible = false;
+	int lifeWorldIndex = 0;
+	int lifeRuleB = LifeEngine::ruleBDefault;
+	int lifeRuleMaskIndex = LifeEngine::RULE_MASK_OFF;
+	int lifeInjectIndex = 0;
+	int fxIndex = OutputFx::SLEW;
+	int quantiserOutputs = Quantiser::OUTPUTS_X;
+	int quantiserScale = 0;
+	int quantiserRoot = 0;
+	int quantiserRange = 1;
+	bool sync = false;
+	bool cellProbability = false;
+	bool audioRateMode = false;
+	int oversampleIndex = 0;
+	bool ruleModulation = false;
+	bool engineModulation = false;
+	std::string lifeCustomRule;
+	LifeRule lifeCustomRuleCompiled;
+	bool lifeCustomRulePending = false;
+	static constexpr std::array<size_t, 9> sequenceLengths{ 2, 3, 4, 6, 8, 12, 16, 32, 64 };
+	static constexpr std::array<size_t, 9> longSequenceLengths{ 128, 256, 512, 1024, 2048, 4096, 8192, 16384, 65536 };
+	static constexpr std::array<size_t, 14> playheadDelays{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 24, 32, 48 };
+	std::array<std::array<int, 3>, 64> uiCommands{};
+	alignas(CACHE_LINE) BenchEngines engines;
+	std::array<AlgoEngine*, BenchEngines::size> engine = engines.getPointers();
+};
+
+template <typename Module>
+static void processModule(Module& m, int frame) {
+	// The member traffic of one Wolfram::process() sample at 1x:
+	// settings and CV into the engine params, triggers, menu params,
+	// the active engine, output FX, DC filter and pulses, and the
+	// UI snapshot every 512 samples
+	const float sampleTime = 1.f / m.srate;
+	for (auto& menu : m.engineMenuParams) {
+		for (int j = 0; j < EngineMenuParams::DELTA_LEN; j++) {
+			menu.menuDelta[j] = 0;
+			menu.menuReset[j] = false;
+		}
+	}
+	int targetOversampleIndex = m.audioRateMode ? m.oversampleIndex : 0;
+	if (targetOversampleIndex != m.activeOversampleIndex)
+		m.activeOversampleIndex = targetOversampleIndex;
+
+	float stepVoltage = m.inputVoltages[0];
+	bool step = m.trigTrigger.process(stepVoltage, 0.1f, 2.f);
+	m.prevStepVoltage = stepVoltage;
+	m.engineModulation = false;
+	if (m.sync && step)
+		m.syncedEngineCv = m.inputVoltages[1] * 0.1f;
+	m.engineIndex = m.engineSelect;
+
+	EngineCoreParams& params = m.engineCoreParams[m.engineIndex];
+	params.step = step;
+	params.ruleCv = rack::clamp(m.inputVoltages[2] * 0.1f, -1.f, 1.f);
+	params.reset = m.resetTrigger.process(m.inputVoltages[3], 0.1f, 2.f);
+	params.sync = m.sync;
+	const auto& activeLengths = m.longLengths ? m.longSequenceLengths : m.sequenceLengths;
+	m.sequenceLength = activeLengths[4];
+	params.length = m.sequenceLength;
+	params.probability = rack::clamp(1.f + m.inputVoltages[4] * 0.1f, 0.f, 1.f);
+	params.cellProbability = m.cellProbability;
+	params.offset = rack::clamp(4 + static_cast<int>(std::round(m.inputVoltages[5] * 0.7f)), 0, 7);
+	params.viewOffset = m.rightMessages[1].viewOffset;
+	params.reverse = m.rightMessages[1].reverse;
+	params.scrub = m.rightMessages[1].scrub;
+	params.transform = m.displayTransformIndex;
+	params.roll = m.displayRoll;
+	params.stampX = params.offset;
+	params.stampY = 0;
+	params.numPlayheads = m.numPlayheads;
+	for (int i = 0; i < MAX_PLAYHEADS; i++) {
+		int playheadLength = m.playheadLengthIndex[i];
+		params.playheadLength[i] = playheadLength ? activeLengths[playheadLength - 1] : 0;
+		params.playheadDelay[i] = m.playheadDelays[m.playheadDelayIndex[i]];
+	}
+
+	if (m.menuTrigger.process(false))
+		m.menuActive = !m.menuActive;
+	if (m.modeTrigger.process(false))
+		m.pageCounter++;
+	m.pageNumber = m.pageCounter % 4;
+	params.miniMenuChanged = false;
+	m.encoderReset = false;
+
+	int injectState = 0;
+	if (m.posInjectTrigger.process(m.inputVoltages[6], 0.1f, 2.f))
+		injectState = 1;
+	else if (m.negInjectTrigger.process(m.inputVoltages[6], -2.f, -0.1f))
+		injectState = -1;
+	params.inject = injectState;
+
+	m.engines.forEach([&](auto& e, int i) { e.updateMenuParams(m.engineMenuParams[i]); });
+	bool quantiseX = (m.quantiserOutputs == Quantiser::OUTPUTS_X) || (m.quantiserOutputs == Quantiser::OUTPUTS_XY);
+	m.outputFx.setAmount(0, 0.5f, static_cast<float>(m.srate), m.audioRateMode);
+	m.outputFx.setAmount(1, 0.5f, static_cast<float>(m.srate), m.audioRateMode);
+
+	EngineOutput out;
+	m.engines.visit(m.engineIndex, [&](auto& engine) { engine.process(params, out); });
+	float io[2] = { quantiseX ? m.quantiser.process(out.xIndex, out.xLevels) : out.x, out.y };
+	m.outputFx.process(io);
+	m.dcFilter[0].process(io[0]);
+	m.dcFilter[1].process(io[1]);
+	if (out.xPulse)
+		m.xPulse.trigger(1e-3f);
+	if (out.yPulse)
+		m.yPulse.trigger(1e-3f);
+	bool pulses = m.xPulse.process(sampleTime) | m.yPulse.process(sampleTime);
+	m.ruleDisplayTimer.process(sampleTime);
+	sink = sink + m.dcFilter[0].highpass() + m.dcFilter[1].highpass() + pulses;
+
+	if ((frame % 512) == 0) {
+		m.uiFlip = !m.uiFlip;
+		EngineToUiLayer* writeState = m.uiFlip ? m.engineToUiLayerA.data() : m.engineToUiLayerB.data();
+		for (int i = 0; i < BenchEngines::size; i++) {
+			writeState[i].display = m.engine[i]->getBufferFrame(0, true);
+			writeState[i].seed = m.engine[i]->getSeed();
+			m.engine[i]->getRuleActiveLabel(writeState[i].ruleActiveLabel);
+		}
+		m.engineToUiLayerPtr.store(writeState, std::memory_order_release);
+	}
+}
+
+struct L1MissCounter {
+	// L1D read misses of this thread through perf_event_open,
+	// unavailable without a PMU or with perf_event_paranoid too high
+	int fd = -1;
+	int error = 0;
+
+	L1MissCounter() {
+#ifdef __linux__
+		perf_event_attr attr{};
+		attr.size = sizeof(attr);
+		attr.type = PERF_TYPE_HW_CACHE;
+		attr.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+		attr.disabled = 1;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+		error = (fd < 0) ? errno : 0;
+#else
+		error = ENOSYS;
+#endif
+	}
+	~L1MissCounter() {
+		if (fd >= 0)
+			close(fd);
+	}
+
+	bool available() const { return fd >= 0; }
+
+	void start() {
+#ifdef __linux__
+		ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+		ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+	}
+
+	uint64_t stop() {
+		uint64_t count = 0;
+#ifdef __linux__
+		ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+		if (read(fd, &count, sizeof(count)) != sizeof(count))
+			count = 0;
+#endif
+		return count;
+	}
+};
+
+template <typename Module>
+struct InstanceSet {
+	// Separately allocated instances, the engines mixed across them
+	// and stepping at different times, processed one after another
+	// each sample as Rack does
+	std::vector<std::unique_ptr<Module>> modules;
+	int frame = 0;
+
+	explicit InstanceSet(int count) {
+		for (int i = 0; i < count; i++) {
+			modules.push_back(std::make_unique<Module>());
+			Module& m = *modules.back();
+			m.engineSelect = i % BenchEngines::size;
+			m.outputFx.setEffect(m.fxIndex);
+			m.dcFilter[0].setCutoffFreq(10.f / m.srate);
+			m.dcFilter[1].setCutoffFreq(10.f / m.srate);
+		}
+	}
+
+	void processSample() {
+		frame++;
+		for (size_t i = 0; i < modules.size(); i++) {
+			// A 750 Hz square trigger, out of phase across instances
+			modules[i]->inputVoltages[0] = (((frame + i * 7) / 32) & 1) ? 10.f : 0.f;
+			processModule(*modules[i], frame);
+		}
+	}
+};
+
+static void benchInstances() {
+	// The Wolfram module's member layout before and after the hot/cold
+	// split, many instances per sample so their state competes for L1.
+	// Both layouts run interleaved and the best of several runs is kept,
+	// L1D misses are read where perf_event_open is available
+	std::printf("Module layout, many instances, ns and L1D misses per instance per sample\n");
+	std::printf("  sizeof unsplit %zu, split %zu bytes\n", sizeof(UnsplitWolframLayout), sizeof(SplitWolframLayout));
+	L1MissCounter counter;
+	if (!counter.available())
+		std::printf("  L1D misses unavailable, perf_event_open: %s\n", std::strerror(counter.error));
+
+	for (int count : { 1, 8, 64, 256 }) {
+		InstanceSet<UnsplitWolframLayout> unsplit(count);
+		InstanceSet<SplitWolframLayout> split(count);
+		int samples = std::max(64, (1 << 17) / count);
+		double bestNs[2] = { 1e30, 1e30 };
+		double bestMisses[2] = { 1e30, 1e30 };
+
+		auto run = [&](auto& set, int layout) {
+			for (int i = 0; i < 64; i++)
+				set.processSample();
+			if (counter.available())
+				counter.start();
+			auto start = std::chrono::steady_clock::now();
+			for (int i = 0; i < samples; i++)
+				set.processSample();
+			auto end = std::chrono::steady_clock::now();
+			double perInstance = static_cast<double>(samples) * count;
+			if (counter.available())
+				bestMisses[layout] = std::min(bestMisses[layout], counter.stop() / perInstance);
+			double ns = std::chrono::duration<double, std::nano>(end - start).count() / perInstance;
+			bestNs[layout] = std::min(bestNs[layout], ns);
+		};
+		for (int i = 0; i < 15; i++) {
+			run(unsplit, 0);
+			run(split, 1);
+		}
+
+		std::printf("  %3d instances: unsplit %6.2f ns, split %6.2f ns (%+.1f%%)", count,
+			bestNs[0], bestNs[1], (bestNs[1] - bestNs[0]) * 100.0 / bestNs[0]);
+		if (counter.available())
+			std::printf(", L1D misses unsplit %.2f, split %.2f", bestMisses[0], bestMisses[1]);
+		std::printf("\n");
+	}
+}
+
+struct Bench {
+	const char* name;
+	void (*run)();
+};
+
+static const Bench benches[] = {
+	{ "oversample", benchOversample },
+	{ "life", benchLifeWorld },
+	{ "dispatch", benchDispatch },
+	{ "instances", benchInstances },
+};
+
+int main(int argc, char** argv) {
+	// No arguments runs every benchmark, otherwise only the named ones
+	for (const Bench& bench : benches) {
+		bool selected = (argc < 2);
+		for (int i = 1; i < argc; i++)
+			selected |= (std::strcmp(argv[i], bench.name) == 0);
+		if (selected)
+			bench.run();
+	}
+	return 0;
+}
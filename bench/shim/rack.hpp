@@ -0,0 +1,183 @@
+// rack.hpp
+// Part of the Modular Mooch Wolfram module (VCV Rack)
+//
+// GitHub: https://github.com/WesDaMooch/Modular-Mooch-VCV
+//
+// Copyright (c) 2026 Wesley Lawrence Leggo-Morrell
+// License: GPL-3.0-or-later
+
+// The small part of the Rack API the engines and DSP use,
+// so the benchmarks build without the Rack SDK. Widgets are empty
+
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <memory>
+#include <string>
+
+#define WARN(format, ...) std::fprintf(stderr, format "\n", ##__VA_ARGS__)
+
+namespace rack {
+
+inline int clamp(int x, int a, int b) { return std::max(std::min(x, b), a); }
+inline float clamp(float x, float a = 0.f, float b = 1.f) { return std::fmax(std::fmin(x, b), a); }
+
+namespace random {
+// xoroshiro128+, as in Rack
+struct Xoroshiro128Plus {
+	uint64_t state[2] = { 0x9E3779B97F4A7C15ULL, 0xD1B54A32D192ED03ULL };
+
+	static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+	uint64_t operator()() {
+		uint64_t s0 = state[0];
+		uint64_t s1 = state[1];
+		uint64_t result = s0 + s1;
+		s1 ^= s0;
+		state[0] = rotl(s0, 55) ^ s1 ^ (s1 << 14);
+		state[1] = rotl(s1, 36);
+		return result;
+	}
+};
+
+inline Xoroshiro128Plus& local() {
+	static thread_local Xoroshiro128Plus rng;
+	return rng;
+}
+
+template <typename T> T get();
+template <> inline uint64_t get<uint64_t>() { return local()(); }
+template <> inline uint32_t get<uint32_t>() { return static_cast<uint32_t>(local()() >> 32); }
+template <> inline uint8_t get<uint8_t>() { return static_cast<uint8_t>(local()() >> 56); }
+template <> inline bool get<bool>() { return local()() >> 63; }
+template <> inline float get<float>() { return (local()() >> 40) * 0x1p-24f; }
+}
+
+namespace simd {
+struct float_4 {
+	float s[4];
+
+	float_4() = default;
+	float_4(float x) { s[0] = s[1] = s[2] = s[3] = x; }
+
+	static float_4 load(const float* p) { float_4 r; for (int i = 0; i < 4; i++) r.s[i] = p[i]; return r; }
+	float operator[](int i) const { return s[i]; }
+	float_4 operator*(const float_4& b) const { float_4 r; for (int i = 0; i < 4; i++) r.s[i] = s[i] * b.s[i]; return r; }
+	float_4& operator+=(const float_4& b) { for (int i = 0; i < 4; i++) s[i] += b.s[i]; return *this; }
+};
+}
+
+namespace dsp {
+// Same state and update rules as Rack's, for the module layout benchmark
+struct PulseGenerator {
+	float remaining = 0.f;
+
+	bool process(float deltaTime) {
+		if (remaining > 0.f) {
+			remaining -= deltaTime;
+			return true;
+		}
+		return false;
+	}
+	void trigger(float duration = 1e-3f) { remaining = std::fmax(remaining, duration); }
+};
+
+struct SchmittTrigger {
+	bool state = true;
+
+	bool process(float in, float lowThreshold = 0.f, float highThreshold = 1.f) {
+		if (state) {
+			if (in <= lowThreshold)
+				state = false;
+		}
+		else if (in >= highThreshold) {
+			state = true;
+			return true;
+		}
+		return false;
+	}
+};
+
+struct BooleanTrigger {
+	bool state = true;
+
+	bool process(bool newState) {
+		bool triggered = newState && !state;
+		state = newState;
+		return triggered;
+	}
+};
+
+struct Timer {
+	float time = 0.f;
+
+	void reset() { time = 0.f; }
+	float process(float deltaTime) { time += deltaTime; return time; }
+};
+
+struct RCFilter {
+	float c = 0.f;
+	float xstate[1] = {};
+	float ystate[1] = {};
+
+	void setCutoff(float r) { c = 2.f / r; }
+	void setCutoffFreq(float f) { setCutoff(2.f * static_cast<float>(M_PI) * f); }
+	void reset() { xstate[0] = ystate[0] = 0.f; }
+	void process(float x) {
+		float y = (x + xstate[0] - ystate[0] * (1 - c)) / (1 + c);
+		xstate[0] = x;
+		ystate[0] = y;
+	}
+	float lowpass() { return ystate[0]; }
+	float highpass() { return xstate[0] - ystate[0]; }
+};
+}
+
+namespace plugin {
+struct Plugin {};
+struct Model {};
+}
+using plugin::Plugin;
+using plugin::Model;
+
+namespace asset {
+inline std::string plugin(Plugin*, const std::string& path) { return path; }
+inline std::string user(const std::string& path) { return path; }
+}
+
+namespace system {
+inline bool exists(const std::string&) { return false; }
+}
+
+struct Svg {
+	static std::shared_ptr<Svg> load(const std::string&) { return nullptr; }
+};
+
+namespace widget {
+struct Widget {
+	void addChildAbove(Widget*, Widget*) {}
+};
+struct SvgWidget : Widget {
+	void setSvg(std::shared_ptr<Svg>) {}
+};
+struct FramebufferWidget : Widget {};
+struct TransformWidget : Widget {};
+}
+
+namespace app {
+struct SvgPort {
+	void setSvg(std::shared_ptr<Svg>) {}
+};
+struct RoundKnob {
+	widget::FramebufferWidget* fb = nullptr;
+	widget::TransformWidget* tw = nullptr;
+	void setSvg(std::shared_ptr<Svg>) {}
+};
+}
+using app::RoundKnob;
+
+}
@@ -20,21 +20,10 @@
 // TODO: figure out if the EngineToUiLayer is the best way to do share data.
 //
 // V1.1:
-// - Replace Slew menu page with FX page.
-// here an effect can be selected that is applied to the output,
-// the amount of effect that is applied is contolled by the Scale params.
-// See Audible Instruments Macro Oscillator 2 for multi-purpose knobs with dynamic tool tips.
-// Effects:
-// GAIN - (0 - 10Vpp).
-// RISE - Slew rise (left = exponencial, right = linear).
-// FALL - Slew fall.
-// FOLD - Wavefolding (left = minus, right = plus)?
 // - V1.1 Manual inculed Effects section. 
 //
 // V1.2:
 // - onRandomize.
-// - New Effects: 
-// XMOD - some cross modulation with the other output (left = ?, right = ?).
 //
 // V2:
 // - Polyphonic engines, multiple outputs
@@ -49,6 +38,14 @@
 #include "Wolfram/algoEngine.hpp"
 #include "Wolfram/wolfEngine.hpp"
 #include "Wolfram/lifeEngine.hpp"
+#include "Wolfram/lifeRule.hpp"
+#include "Wolfram/generationsEngine.hpp"
+#include "Wolfram/volumeEngine.hpp"
+#include "Wolfram/decimator.hpp"
+#include "Wolfram/outputFx.hpp"
+#include "Wolfram/quantiser.hpp"
+#include "Wolfram/expanderMessage.hpp"
+#include "Wolfram/engineList.hpp"
 #include <string>
 #include <atomic>
 #include <cstdio>
@@ -56,35 +53,13 @@
 #include <cstdlib>
 #include <inttypes.h>
 
-static constexpr int NUM_ENGINES = 2;
+// Engine registry, order sets the menu, engine CV and save slots
+using Engines = EngineList<WolfEngine, LifeEngine, GenerationsEngine, VolumeEngine>;
+static constexpr int NUM_ENGINES = Engines::size;
 static constexpr int NUM_MENU_PAGES = 4;
 static constexpr int NUM_DISPLAY_STYLES = 5;
 static constexpr int NUM_CELL_STYLES = 2;
 
-class SlewLimiter {
-public:
-	void setSlewAmountMs(float slew_ms, float sr) {
-		if (sr <= 0) 
-			sr = 1;
-
-		slew_ms = rack::clamp(slew_ms, 1e-3f, 1000.f);
-		slew = (1000.f / sr) / slew_ms;
-	}
-
-	void reset() { 
-		y = 0; 
-	}
-
-	float process(float x) {
-		y += rack::clamp(x - y, -slew, slew);
-		return y;
-	}
-
-protected:
-	float y = 0.f;
-	float slew = 20.f;
-};
-
 struct Wolfram : Module {
 	enum ParamId {
 		SELECT_PARAM,
@@ -156,6 +131,51 @@ struct Wolfram : Module {
 		void setDisplayValueString(std::string s) override {}
 	};
 
+	struct ScaleParamQuantity : ParamQuantity {
+		// Custom behaviour to display the selected effect when hovering over the Scale params
+		std::string getLabel() override {
+			std::string channel = (paramId == X_SCALE_PARAM) ? "X " : "Y ";
+			auto* m = static_cast<Wolfram*>(module);
+			if (!m)
+				return channel + "CV Scale";
+
+			std::string label = OutputFx::effectLabel[m->fxIndex];
+			for (char& c : label)
+				c = std::tolower(static_cast<unsigned char>(c));
+			label[0] = std::toupper(static_cast<unsigned char>(label[0]));
+			return channel + label;
+		}
+
+		std::string getDisplayValueString() override {
+			auto* m = static_cast<Wolfram*>(module);
+			int fx = m ? m->fxIndex : OutputFx::GAIN;
+			float value = getValue();
+
+			if (fx == OutputFx::GAIN)
+				return string::f("%.2f", value * 10.f);
+
+			static const char* sides[OutputFx::NUM_EFFECTS][2] = {
+				{ "", "" },
+				{ "exp", "lin" },
+				{ "exp", "lin" },
+				{ "minus", "plus" },
+				{ "ring", "amp" },
+				{ "exp", "lin" }
+			};
+			float bipolar = (value * 2.f) - 1.f;
+			int percent = static_cast<int>(std::round(std::fabs(bipolar) * 100.f));
+			if (percent == 0)
+				return "0%";
+			return string::f("%d%% %s", percent, sides[fx][bipolar > 0.f]);
+		}
+
+		std::string getUnit() override {
+			auto* m = static_cast<Wolfram*>(module);
+			bool gain = !m || (m->fxIndex == OutputFx::GAIN);
+			return gain ? "V" : "";
+		}
+	};
+
 	struct LengthParamQuantity : ParamQuantity {
 		// Custom behaviour to display sequence length when hovering over Length knob
 		float getDisplayValue() override {
@@ -167,57 +187,148 @@ struct Wolfram : Module {
 		void setDisplayValueString(std::string s) override {}
 	};
 
-	// Engine
-	WolfEngine wolfEngine;
-	LifeEngine lifeEngine;
-	std::array<AlgoEngine*, NUM_ENGINES> engine{};
-	std::array<EngineCoreParams, NUM_ENGINES> engineCoreParams{};
+	// Member layout, hot audio state first and on its own cache lines,
+	// then the UI snapshot, then settings written by the UI thread,
+	// then the large, cold engine storage
+	static constexpr size_t CACHE_LINE = 64;
+
+	// Audio thread, read and written every sample
+	alignas(CACHE_LINE) std::array<EngineCoreParams, NUM_ENGINES> engineCoreParams{};
 	std::array<EngineMenuParams, NUM_ENGINES> engineMenuParams{};
-	static constexpr int engineDefault = 0;
-	int engineSelect = engineDefault;
-	float syncedEngineCv = 0;
 	int engineIndex = 0;
-
-	// UI
-	static constexpr int ENGINE_TO_UI_UPDATE_INTERVAL = 512; // TODO: needs updating onSamplerateChange.
-	static constexpr float MINI_MENU_DISPLAY_TIME = 0.75f;
-	std::array<EngineToUiLayer, NUM_ENGINES> engineToUiLayerA{};
-	std::array<EngineToUiLayer, NUM_ENGINES> engineToUiLayerB{};
-	std::atomic<EngineToUiLayer*> engineToUiLayerPtr{ engineToUiLayerA.data() };
+	float syncedEngineCv = 0;
+	size_t sequenceLength = 8;
+	int activeOversampleIndex = 0;
+	int srate = 44100;
+	float prevStepVoltage = 0.f;
+	float prevEncoderValue = 0.f;
+	bool encoderReset = false;
 	int pageCounter = 0;
 	int pageNumber = 0;
 	bool menuActive = false;
-	int displayStyleIndex = 0;
-	int cellStyleIndex = 0;
 	bool miniMenuActive = false;
 	bool uiFlip = false;
 
+	// DSP
+	dsp::PulseGenerator xPulse, yPulse;
+	dsp::SchmittTrigger trigTrigger, resetTrigger, posInjectTrigger, negInjectTrigger;
+	dsp::BooleanTrigger menuTrigger, modeTrigger;
+	dsp::Timer ruleDisplayTimer;
+	dsp::RCFilter dcFilter[2];
+	std::array<std::array<float, MAX_OVERSAMPLE>, 2> oversampleBuffer{};
+	OutputFx outputFx;
+	Quantiser quantiser;
+	PolyphaseDecimator decimator[2];
+
+	// Expander
+	std::array<ExpanderToWolframMessage, 2> rightMessages{};
+
+	// UI, engine snapshots written by the audio thread and read by the display.
+	// Each buffer starts its own cache line, away from the hot state
+	static constexpr int ENGINE_TO_UI_UPDATE_INTERVAL = 512; // TODO: needs updating onSamplerateChange.
+	static constexpr float MINI_MENU_DISPLAY_TIME = 0.75f;
+	alignas(CACHE_LINE) std::array<EngineToUiLayer, NUM_ENGINES> engineToUiLayerA{};
+	alignas(CACHE_LINE) std::array<EngineToUiLayer, NUM_ENGINES> engineToUiLayerB{};
+	alignas(CACHE_LINE) std::atomic<EngineToUiLayer*> engineToUiLayerPtr{ engineToUiLayerA.data() };
+
+	// Settings, the context menu and widgets send changes through uiCommands,
+	// the audio thread applies them
+	static constexpr int engineDefault = 0;
+	alignas(CACHE_LINE) int engineSelect = engineDefault;
+	int displayStyleIndex = 0;
+	int cellStyleIndex = 0;
+	int displayTransformIndex = AlgoEngine::TRANSFORM_NONE;
+	int displayRoll = 0;
+
 	// Select encoder
 	static constexpr float ENCODER_INDENT = 1.f / 30.f;
-	float prevEncoderValue = 0.f;
-	bool encoderReset = false;
 
 	// Parameters
-	static constexpr int NUM_SEQUENCE_LENGTHS = 9;
-	std::array<size_t, NUM_SEQUENCE_LENGTHS> sequenceLengths { 
-		2, 3, 4, 6, 8, 12, 16, 32, 64 
-	};
-	size_t sequenceLength = 8;
-	int slewValue = 0;
+	bool longLengths = false;
+	int numPlayheads = 0;
+	std::array<int, MAX_PLAYHEADS> playheadLengthIndex{};
+	std::array<int, MAX_PLAYHEADS> playheadDelayIndex{};
+	int wolfWorldIndex = 0;
+	bool wolfReversible = false;
+	int lifeWorldIndex = 0;
+	int lifeRuleB = LifeEngine::ruleBDefault;
+	int lifeRuleMaskIndex = LifeEngine::RULE_MASK_OFF;
+	int lifeInjectIndex = 0;	// Random cells, then stamps
+	int fxIndex = OutputFx::effectDefault;
+	int quantiserOutputs = Quantiser::OUTPUTS_OFF;
+	int quantiserScale = 0;
+	int quantiserRoot = 0;
+	int quantiserRange = 1;
 	bool sync = false;
+	bool cellProbability = false;
 	bool audioRateMode = false;
+	int oversampleIndex = 0;
 	bool ruleModulation = false;
 	bool engineModulation = false;
-	float prevStepVoltage = 0.f;
+	std::string lifeCustomRule;
+	LifeRule lifeCustomRuleCompiled;
+	bool lifeCustomRulePending = false;
 
-	// DSP
-	int srate = 44100;	
-	dsp::PulseGenerator xPulse, yPulse;
-	dsp::SchmittTrigger trigTrigger, resetTrigger, posInjectTrigger, negInjectTrigger;
-	dsp::BooleanTrigger menuTrigger, modeTrigger;
-	dsp::Timer ruleDisplayTimer;
-	dsp::RCFilter dcFilter[2];
-	SlewLimiter slewLimiter[2];
+	// Tables, shared by every instance
+	static constexpr int NUM_SEQUENCE_LENGTHS = 9;
+	static constexpr std::array<size_t, NUM_SEQUENCE_LENGTHS> sequenceLengths { 
+		2, 3, 4, 6, 8, 12, 16, 32, 64 
+	};
+	// Long lengths share the knob positions,
+	// Wolf and Life loop them on their 8 cell boards, other engines stop at 64
+	static constexpr std::array<size_t, NUM_SEQUENCE_LENGTHS> longSequenceLengths {
+		128, 256, 512, 1024, 2048, 4096, 8192, 16384, 65536
+	};
+	// Extra playheads, length index 0 follows the main length
+	static constexpr int NUM_PLAYHEAD_DELAYS = 14;
+	static constexpr std::array<size_t, NUM_PLAYHEAD_DELAYS> playheadDelays {
+		0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 24, 32, 48
+	};
+
+	// UI to audio command queue, single producer (UI thread)
+	// and single consumer (audio thread)
+	struct UiCommand {
+		enum Id {
+			ENGINE_SELECT,
+			SYNC,
+			CELL_PROBABILITY,
+			LONG_LENGTHS,
+			AUDIO_RATE,
+			OVERSAMPLE,
+			QUANTISER_OUTPUTS,
+			QUANTISER_SCALE,
+			QUANTISER_ROOT,
+			QUANTISER_RANGE,
+			WOLF_WORLD,
+			WOLF_REVERSIBLE,
+			LIFE_WORLD,
+			LIFE_INJECT,
+			LIFE_RULE_MASK,
+			LIFE_RULE_B,
+			NUM_PLAYHEADS,
+			PLAYHEAD_LENGTH,
+			PLAYHEAD_DELAY,
+			DISPLAY_STYLE,
+			CELL_STYLE,
+			DISPLAY_TRANSFORM,
+			DISPLAY_ROLL,
+			ENCODER_RESET
+		};
+		Id id = ENGINE_SELECT;
+		int value = 0;
+		int index = 0;	// Playhead, for the per playhead settings
+	};
+	static constexpr size_t UI_COMMAND_QUEUE_SIZE = 64;
+	static constexpr int UI_COMMAND_INTERVAL = 32;
+	dsp::RingBuffer<UiCommand, UI_COMMAND_QUEUE_SIZE> uiCommands;
+
+	// Engine, large and only touched by the active engine's process
+	alignas(CACHE_LINE) Engines engines;
+	WolfEngine& wolfEngine = engines.get<WolfEngine>();
+	LifeEngine& lifeEngine = engines.get<LifeEngine>();
+	GenerationsEngine& generationsEngine = engines.get<GenerationsEngine>();
+	VolumeEngine& volumeEngine = engines.get<VolumeEngine>();
+	std::array<AlgoEngine*, NUM_ENGINES> engine = engines.getPointers();
 
 	Wolfram() {
 		config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
@@ -230,14 +341,14 @@ struct Wolfram : Module {
 		paramQuantities[PROBABILITY_PARAM]->displayPrecision = 3;
 		configParam(OFFSET_PARAM, 0.f, 7.f, 4.f, "Offset", "", 0.f, 1.f, -4.f);
 		paramQuantities[OFFSET_PARAM]->snapEnabled = true;
-		configParam(X_SCALE_PARAM, 0.f, 1.f, 0.5f, "X CV Scale", "V", 0.f, 10.f);
+		configParam<ScaleParamQuantity>(X_SCALE_PARAM, 0.f, 1.f, 0.5f, "X CV Scale", "V", 0.f, 10.f);
 		paramQuantities[X_SCALE_PARAM]->displayPrecision = 3;
-		configParam(Y_SCALE_PARAM, 0.f, 1.f, 0.5f, "Y CV Scale", "V", 0.f, 10.f);
+		configParam<ScaleParamQuantity>(Y_SCALE_PARAM, 0.f, 1.f, 0.5f, "Y CV Scale", "V", 0.f, 10.f);
 		paramQuantities[Y_SCALE_PARAM]->displayPrecision = 3;
 		configInput(RESET_INPUT, "Reset");
 		configInput(PROBABILITY_CV_INPUT, "Probability CV");
 		configInput(RULE_CV_INPUT, "Rule CV");
-		configInput(ENGINE_CV_INPUT, "Algorithm CV");
+		configInput(ENGINE_CV_INPUT, "Algorithm CV, Wolf 0V, Life 5V, Generations -5V, 3D Life -7.5V");
 		configInput(OFFSET_CV_INPUT, "Offset CV");
 		configInput(TRIG_INPUT, "Trigger");
 		configInput(INJECT_INPUT, "Inject");
@@ -251,22 +362,136 @@ struct Wolfram : Module {
 		configLight(Y_LIGHT, "Y");
 		configLight(Y_PULSE_LIGHT, "Y Pulse");
 
-		// Load engines
-		engine[0] = &wolfEngine;
-		engine[1] = &lifeEngine;
+		rightExpander.producerMessage = &rightMessages[0];
+		rightExpander.consumerMessage = &rightMessages[1];
 
 		onSampleRateChange();
+		updateEngineSettings();
+	}
+
+	// Static dispatch for the audio path, the engine classes are final
+	// so calls on them are resolved at compile time and can be inlined.
+	// engine[] and the virtual interface stay for the UI and saving
+	template <typename F>
+	void visitEngine(int index, F&& f) {
+		engines.visit(index, f);
 	}
 
 	void setEngine(int newEngineSelect, float newEngineCv = 0.f) {
+		// Wolf and Life keep their original CV map, Life from 5V. 
+		// The engines added after them take -5V and below, 2.5V apart,
+		// so patches built on the old map pick the same engines
 		engineSelect = rack::clamp(newEngineSelect, 0, NUM_ENGINES - 1);
-		int engineCv = rack::clamp(
-			static_cast<int>(std::round(newEngineCv * (NUM_ENGINES - 1))),
-			0, NUM_ENGINES - 1
-		);
+		int engineCv = rack::clamp(static_cast<int>(std::round(newEngineCv)), 0, 1);
+		float negativeVoltage = newEngineCv * -10.f;
+		if (negativeVoltage >= 5.f)
+			engineCv = rack::clamp(2 + static_cast<int>((negativeVoltage - 5.f) / 2.5f), 0, NUM_ENGINES - 1);
 		engineIndex = engineModulation ? engineCv : engineSelect;
 	}
 
+	void pushCommand(UiCommand::Id id, int value = 0, int index = 0) {
+		// UI thread, commands past a full queue are dropped
+		if (uiCommands.full())
+			return;
+		UiCommand command;
+		command.id = id;
+		command.value = value;
+		command.index = index;
+		uiCommands.push(command);
+	}
+
+	void applyCommands() {
+		// Audio thread, drained at the top of process() once every
+		// UI_COMMAND_INTERVAL samples so changes land on a sample boundary.
+		// Engine settings are pushed to the engines here, not polled
+		while (!uiCommands.empty()) {
+			UiCommand command = uiCommands.shift();
+			int value = command.value;
+			int playhead = rack::clamp(command.index, 0, MAX_PLAYHEADS - 1);
+			switch (command.id) {
+				case UiCommand::ENGINE_SELECT:		engineSelect = rack::clamp(value, 0, NUM_ENGINES - 1); break;
+				case UiCommand::SYNC:				sync = value; break;
+				case UiCommand::CELL_PROBABILITY:	cellProbability = value; break;
+				case UiCommand::LONG_LENGTHS:		longLengths = value; break;
+				case UiCommand::AUDIO_RATE:
+					audioRateMode = value;
+					onSampleRateChange();
+					break;
+				case UiCommand::OVERSAMPLE:			oversampleIndex = value; break;
+				case UiCommand::QUANTISER_OUTPUTS:	quantiserOutputs = value; break;
+				case UiCommand::QUANTISER_SCALE:
+					quantiserScale = value;
+					quantiser.set(quantiserScale, quantiserRoot, quantiserRange);
+					break;
+				case UiCommand::QUANTISER_ROOT:
+					quantiserRoot = value;
+					quantiser.set(quantiserScale, quantiserRoot, quantiserRange);
+					break;
+				case UiCommand::QUANTISER_RANGE:
+					quantiserRange = value;
+					quantiser.set(quantiserScale, quantiserRoot, quantiserRange);
+					break;
+				case UiCommand::WOLF_WORLD:
+					wolfWorldIndex = value;
+					wolfEngine.setWorldSize(wolfWorldIndex);
+					break;
+				case UiCommand::WOLF_REVERSIBLE:
+					wolfReversible = value;
+					wolfEngine.setReversible(wolfReversible);
+					break;
+				case UiCommand::LIFE_WORLD:
+					lifeWorldIndex = value;
+					lifeEngine.setWorldSize(lifeWorldIndex);
+					break;
+				case UiCommand::LIFE_INJECT:
+					lifeInjectIndex = value;
+					lifeEngine.setStamp(lifeInjectIndex - 1);
+					break;
+				case UiCommand::LIFE_RULE_MASK:
+					lifeRuleMaskIndex = value;
+					lifeEngine.setRuleMask(lifeRuleMaskIndex, wolfEngine.getBufferFrame(0, true));
+					break;
+				case UiCommand::LIFE_RULE_B:
+					lifeRuleB = value;
+					lifeEngine.setRuleB(lifeRuleB);
+					break;
+				case UiCommand::NUM_PLAYHEADS:		numPlayheads = value; break;
+				case UiCommand::PLAYHEAD_LENGTH:	playheadLengthIndex[playhead] = value; break;
+				case UiCommand::PLAYHEAD_DELAY:		playheadDelayIndex[playhead] = value; break;
+				case UiCommand::DISPLAY_STYLE:		displayStyleIndex = value; break;
+				case UiCommand::CELL_STYLE:			cellStyleIndex = value; break;
+				case UiCommand::DISPLAY_TRANSFORM:	displayTransformIndex = value; break;
+				case UiCommand::DISPLAY_ROLL:		displayRoll = value; break;
+				case UiCommand::ENCODER_RESET:		encoderReset = true; break;
+			}
+		}
+	}
+
+	void updateEngineSettings() {
+		// Hands every engine setting over at once, on creation, reset and load.
+		// The setters only rebuild what changed
+		wolfEngine.setWorldSize(wolfWorldIndex);
+		wolfEngine.setReversible(wolfReversible);
+		lifeEngine.setWorldSize(lifeWorldIndex);
+		lifeEngine.setRuleB(lifeRuleB);
+		lifeEngine.setRuleMask(lifeRuleMaskIndex, wolfEngine.getBufferFrame(0, true));
+		lifeEngine.setStamp(lifeInjectIndex - 1);
+		quantiser.set(quantiserScale, quantiserRoot, quantiserRange);
+	}
+
+	size_t getHistoryDepth() {
+		return longLengths ? MAX_LONG_SEQUENCE_LENGTH : MAX_SEQUENCE_LENGTH;
+	}
+
+	void updateHistoryDepth() {
+		// UI thread, frees swapped out sequence buffers and allocates
+		// one for the depth Long lengths needs, the engines swap it in
+		wolfEngine.collectHistory();
+		lifeEngine.collectHistory();
+		wolfEngine.requestHistoryDepth(getHistoryDepth());
+		lifeEngine.requestHistoryDepth(getHistoryDepth());
+	}
+
 	void updateEngineToUiLayer() {
 		uiFlip = !uiFlip;
 		EngineToUiLayer* writeState = uiFlip ? engineToUiLayerA.data() : engineToUiLayerB.data();
@@ -283,28 +508,65 @@ struct Wolfram : Module {
 		engineToUiLayerPtr.store(writeState, std::memory_order_release);
 	}
 
-	void setSlew(int newSlewSelect) {
-		// Skew slewParam (0 - 100%) -> (0 - 1)
-		// Convert to ms, if Audio Rate mode (0 - 10ms) else (0 - 1000ms)
-		slewValue = rack::clamp(newSlewSelect, 0, 100);
-		float slewSkew = std::pow(slewValue * 0.01f, 2.f);
-		float slew = audioRateMode ? (slewSkew * 10.f) : (slewSkew * 1000.f);
+	void setFx(int newFxSelect) {
+		// Coefficients are rebuilt on the next sample,
+		// the effect runs at the oversampled rate
+		fxIndex = (newFxSelect + OutputFx::NUM_EFFECTS) % OutputFx::NUM_EFFECTS;
+		outputFx.setEffect(fxIndex);
+		outputFx.reset();
+	}
+
+	bool setLifeCustomRule(const std::string& text) {
+		// Called from the UI thread, the rule is compiled here
+		// and handed to the Life engine, an empty string removes it
+		if (text.empty()) {
+			lifeCustomRule.clear();
+		}
+		else {
+			LifeRule newRule;
+			if (!parseLifeRule(text, newRule))
+				return false;
+
+			lifeCustomRule = text;
+			lifeCustomRuleCompiled = newRule;
+		}
+
+		lifeCustomRulePending = true;
+		updateLifeCustomRule();
+		return true;
+	}
+
+	void updateLifeCustomRule() {
+		// UI thread, the engine takes one rule at a time,
+		// a newer one waits here until it has taken the last
+		if (lifeCustomRulePending)
+			lifeCustomRulePending = !lifeEngine.setCustomRule(lifeCustomRule.empty() ? nullptr : &lifeCustomRuleCompiled);
+	}
+
+	int getOversample() {
+		return oversampleFactors[activeOversampleIndex];
+	}
+
+	void setOversample(int newOversampleIndex) {
+		// Called from the audio thread when the active factor changes,
+		// oversampling is only used in Audio Rate mode
+		activeOversampleIndex = rack::clamp(newOversampleIndex, 0, NUM_OVERSAMPLE_FACTORS - 1);
+		outputFx.reset();
 
 		for (int i = 0; i < 2; i++)
-			slewLimiter[i].setSlewAmountMs(slew, srate);
+			decimator[i].setFactor(activeOversampleIndex);
 	}
 
 	void onSampleRateChange() override {
 		srate = APP->engine->getSampleRate();
 
 		// Set DC blocker to ~10Hz,
-		// Set Slew time (ms)
-		setSlew(slewValue);
+		// FX coefficients are rebuilt on the next sample
+		outputFx.reset();
 
 		for (int i = 0; i < 2; i++) {
 			dcFilter[i].setCutoffFreq(10.f / srate);
 			dcFilter[i].reset();
-			slewLimiter[i].reset();
 		}
 	}
 
@@ -312,18 +574,43 @@ struct Wolfram : Module {
 		Module::onReset(e);
 
 		sync = false;
+		cellProbability = false;
+		longLengths = false;
+		wolfEngine.setHistoryDepth(getHistoryDepth());
+		lifeEngine.setHistoryDepth(getHistoryDepth());
 		audioRateMode = false;
+		oversampleIndex = 0;
 		menuActive = false;
 		miniMenuActive = false;
 		pageCounter = 0; 
-		setSlew(0);
+		setFx(OutputFx::effectDefault);
 		setEngine(0);
+		quantiserOutputs = Quantiser::OUTPUTS_OFF;
+		quantiserScale = 0;
+		quantiserRoot = 0;
+		quantiserRange = 1;
+		numPlayheads = 0;
+		playheadLengthIndex = {};
+		playheadDelayIndex = {};
+		wolfWorldIndex = 0;
+		wolfReversible = false;
+		lifeWorldIndex = 0;
+		wolfEngine.setWorldSize(wolfWorldIndex);
+		wolfEngine.setReversible(wolfReversible);
+		lifeEngine.setWorldSize(lifeWorldIndex);
+		setLifeCustomRule("");
+		lifeRuleB = LifeEngine::ruleBDefault;
+		lifeRuleMaskIndex = LifeEngine::RULE_MASK_OFF;
+		lifeInjectIndex = 0;
 		
 		for (int i = 0; i < NUM_ENGINES; i++)
 			engine[i]->reset();
+		updateEngineSettings();
 		
 		displayStyleIndex = 0;
 		cellStyleIndex = 0;
+		displayTransformIndex = AlgoEngine::TRANSFORM_NONE;
+		displayRoll = 0;
 	}
 
 	// Whhhat, pretty cool way of doing things
@@ -364,13 +651,183 @@ struct Wolfram : Module {
 		}
 	}
 	
+	static std::string packDeltaFrames(const std::vector<uint64_t>& frames) {
+		// Long buffers are saved as the XOR of each frame with the one before,
+		// a byte mask then only the bytes that changed.
+		// Settled patterns cost a byte a frame
+		std::string out;
+		uint64_t prevFrame = 0;
+		char buf[3] = {};
+
+		for (uint64_t frame : frames) {
+			uint64_t delta = frame ^ prevFrame;
+			prevFrame = frame;
+
+			uint8_t mask = 0;
+			for (int i = 0; i < 8; i++) {
+				if ((delta >> (i * 8)) & 0xFFULL)
+					mask |= 1 << i;
+			}
+
+			snprintf(buf, sizeof(buf), "%02x", mask);
+			out.append(buf);
+			for (int i = 0; i < 8; i++) {
+				if ((mask >> i) & 1) {
+					snprintf(buf, sizeof(buf), "%02x", static_cast<unsigned>((delta >> (i * 8)) & 0xFFULL));
+					out.append(buf);
+				}
+			}
+		}
+
+		return out;
+	}
+
+	static void unpackDeltaFrames(const char* str, std::vector<uint64_t>& frames) {
+		// Frames past the end of the string are left empty
+		if (!str)
+			return;
+
+		size_t len = std::strlen(str);
+		size_t pos = 0;
+		uint64_t frame = 0;
+		char buf[3] = {};
+
+		auto readByte = [&](uint8_t& out) {
+			if (pos + 2 > len)
+				return false;
+			std::memcpy(buf, str + pos, 2);
+			out = static_cast<uint8_t>(std::strtoul(buf, nullptr, 16));
+			pos += 2;
+			return true;
+		};
+
+		for (uint64_t& outFrame : frames) {
+			uint8_t mask = 0;
+			if (!readByte(mask))
+				return;
+
+			for (int i = 0; i < 8; i++) {
+				uint8_t byte = 0;
+				if (((mask >> i) & 1) && readByte(byte))
+					frame ^= static_cast<uint64_t>(byte) << (i * 8);
+			}
+			outFrame = frame;
+		}
+	}
+
+	// Engine state blob, base64 in the patch. Little endian, version 1 is
+	// a header ("WLFM", version, engine count, frames per engine as u16)
+	// then per engine: read head, write head (u32), rule, seed, mode (i32),
+	// saved display (u64) and the frames (u64 each)
+	static constexpr uint8_t ENGINE_STATE_VERSION = 1;
+	static constexpr size_t ENGINE_STATE_HEADER = 8;
+	static constexpr size_t ENGINE_STATE_SIZE = 20 + 8 + (MAX_SEQUENCE_LENGTH * 8);
+
+	std::string packEngineState() {
+		std::vector<uint8_t> blob;
+		blob.reserve(ENGINE_STATE_HEADER + (NUM_ENGINES * ENGINE_STATE_SIZE));
+
+		auto write = [&](uint64_t value, int bytes) {
+			for (int i = 0; i < bytes; i++)
+				blob.push_back(static_cast<uint8_t>(value >> (i * 8)));
+		};
+
+		blob.insert(blob.end(), { 'W', 'L', 'F', 'M' });
+		write(ENGINE_STATE_VERSION, 1);
+		write(NUM_ENGINES, 1);
+		write(MAX_SEQUENCE_LENGTH, 2);
+
+		uint64_t frames[MAX_SEQUENCE_LENGTH];
+		for (int i = 0; i < NUM_ENGINES; i++) {
+			write(static_cast<uint32_t>(engine[i]->getReadHead()), 4);
+			write(static_cast<uint32_t>(engine[i]->getWriteHead()), 4);
+			write(static_cast<uint32_t>(engine[i]->getRuleSelect()), 4);
+			write(static_cast<uint32_t>(engine[i]->getSeed()), 4);
+			write(static_cast<uint32_t>(engine[i]->getMode()), 4);
+			write(engine[i]->getBufferFrame(0, false, true), 8);
+			engine[i]->getBufferFrames(frames, MAX_SEQUENCE_LENGTH);
+			for (uint64_t frame : frames)
+				write(frame, 8);
+		}
+
+		return string::toBase64(blob.data(), blob.size());
+	}
+
+	bool unpackEngineState(const std::string& str) {
+		// False when the blob can not be read, the caller falls back
+		// to the older per engine keys
+		std::vector<uint8_t> blob;
+		try {
+			blob = string::fromBase64(str);
+		}
+		catch (std::exception&) {
+			return false;
+		}
+
+		size_t pos = 0;
+		auto read = [&](int bytes) {
+			uint64_t value = 0;
+			for (int i = 0; i < bytes; i++)
+				value |= static_cast<uint64_t>(blob[pos++]) << (i * 8);
+			return value;
+		};
+
+		if ((blob.size() < ENGINE_STATE_HEADER) || (std::memcmp(blob.data(), "WLFM", 4) != 0))
+			return false;
+		pos = 4;
+		int version = static_cast<int>(read(1));
+		int numEngines = static_cast<int>(read(1));
+		int numFrames = static_cast<int>(read(2));
+		if ((version != ENGINE_STATE_VERSION) || (numFrames != MAX_SEQUENCE_LENGTH))
+			return false;
+		if (blob.size() < ENGINE_STATE_HEADER + (numEngines * ENGINE_STATE_SIZE))
+			return false;
+
+		// Engines missing from an older blob keep their defaults
+		uint64_t frames[MAX_SEQUENCE_LENGTH];
+		for (int i = 0; i < numEngines; i++) {
+			if (i >= NUM_ENGINES) {
+				pos += ENGINE_STATE_SIZE;
+				continue;
+			}
+			engine[i]->setReadHead(static_cast<size_t>(read(4)));
+			engine[i]->setWriteHead(static_cast<size_t>(read(4)));
+			engine[i]->setRuleSelect(static_cast<int32_t>(read(4)));
+			engine[i]->setSeed(static_cast<int32_t>(read(4)));
+			engine[i]->setMode(static_cast<int32_t>(read(4)));
+			engine[i]->setBufferFrame(read(8), 0, true);
+			for (uint64_t& frame : frames)
+				frame = read(8);
+			engine[i]->setBufferFrames(frames, MAX_SEQUENCE_LENGTH);
+			engine[i]->updateDisplay(false);
+		}
+		return true;
+	}
+
 	json_t* dataToJson() override {
 		json_t* rootJ = json_object();
 
 		// Save sequencer settings
 		json_object_set_new(rootJ, "audioRateMode", json_boolean(audioRateMode));
+		json_object_set_new(rootJ, "oversample", json_integer(oversampleIndex));
 		json_object_set_new(rootJ, "sync", json_boolean(sync));
-		json_object_set_new(rootJ, "slewValue", json_integer(slewValue));
+		json_object_set_new(rootJ, "cellProbability", json_boolean(cellProbability));
+		json_object_set_new(rootJ, "longLengths", json_boolean(longLengths));
+		json_object_set_new(rootJ, "fx", json_integer(fxIndex));
+		json_object_set_new(rootJ, "quantiserOutputs", json_integer(quantiserOutputs));
+		json_object_set_new(rootJ, "quantiserScale", json_integer(quantiserScale));
+		json_object_set_new(rootJ, "quantiserRoot", json_integer(quantiserRoot));
+		json_object_set_new(rootJ, "quantiserRange", json_integer(quantiserRange));
+		json_object_set_new(rootJ, "playheads", json_integer(numPlayheads));
+
+		json_t* playheadLengthsJ = json_array();
+		json_t* playheadDelaysJ = json_array();
+		for (int i = 0; i < MAX_PLAYHEADS; i++) {
+			json_array_append_new(playheadLengthsJ, json_integer(playheadLengthIndex[i]));
+			json_array_append_new(playheadDelaysJ, json_integer(playheadDelayIndex[i]));
+		}
+		json_object_set_new(rootJ, "playheadLengths", playheadLengthsJ);
+		json_object_set_new(rootJ, "playheadDelays", playheadDelaysJ);
 
 		// Save engine selection
 		json_object_set_new(rootJ, "engine", json_integer(engineSelect));
@@ -378,43 +835,91 @@ struct Wolfram : Module {
 		// Save UI settings
 		json_object_set_new(rootJ, "displayStyle", json_integer(displayStyleIndex));
 		json_object_set_new(rootJ, "cellStyle", json_integer(cellStyleIndex));
+		json_object_set_new(rootJ, "displayTransform", json_integer(displayTransformIndex));
+		json_object_set_new(rootJ, "displayRoll", json_integer(displayRoll));
 
-		json_t* readHeadsJ = json_array();
-		json_t* writeHeadsJ = json_array();
-		json_t* rulesJ = json_array();
-		json_t* seedsJ = json_array();
-		json_t* modesJ = json_array();
-		json_t* displaysJ = json_array();
-		json_t* buffersJ = json_array();
+		// Save engine heads, rules, seeds, modes, displays and buffers
+		json_object_set_new(rootJ, "engineState", json_string(packEngineState().c_str()));
 
-		for (int i = 0; i < NUM_ENGINES; i++) {
-			json_array_append_new(rulesJ, json_integer(engine[i]->getRuleSelect()));
-			json_array_append_new(seedsJ, json_integer(engine[i]->getSeed()));
-			json_array_append_new(modesJ, json_integer(engine[i]->getMode()));
-			json_array_append_new(readHeadsJ, json_integer(engine[i]->getReadHead()));
-			json_array_append_new(writeHeadsJ, json_integer(engine[i]->getWriteHead()));
-
-			// Save display frame
-			uint64_t matrixDisplay = engine[i]->getBufferFrame(0, false, true);
-			char displayStr[17];
-			snprintf(displayStr, sizeof(displayStr), "%016" PRIx64, matrixDisplay);
-			json_array_append_new(displaysJ, json_string(displayStr));
-
-			// Pack entire buffer into one string
-			uint64_t frames[MAX_SEQUENCE_LENGTH];
+		// Save Wolf and Life long buffers, up to their last living frame
+		std::array<AlgoEngine*, 2> longEngines{ &wolfEngine, &lifeEngine };
+		std::array<const char*, 2> longKeys{ "wolfLongBuffer", "lifeLongBuffer" };
+		for (int i = 0; i < 2; i++) {
+			int count = MAX_LONG_SEQUENCE_LENGTH;
+			while ((count > MAX_SEQUENCE_LENGTH) && (longEngines[i]->getBufferFrame(count - 1) == 0))
+				count--;
+			if (count <= MAX_SEQUENCE_LENGTH)
+				continue;
+
+			std::vector<uint64_t> frames(count);
+			longEngines[i]->getBufferFrames(frames.data(), count);
+			json_object_set_new(rootJ, longKeys[i], json_string(packDeltaFrames(frames).c_str()));
+		}
+
+		// Save Wolf wide world, every frame of the sequence
+		json_object_set_new(rootJ, "wolfWorld", json_integer(wolfWorldIndex));
+		int worldWords = WolfEngine::worldSizes[wolfEngine.getWorldSize()] / 64;
+		if (worldWords > 0) {
+			std::vector<uint64_t> worldWordsData(MAX_SEQUENCE_LENGTH * worldWords);
+			for (int i = 0; i < MAX_SEQUENCE_LENGTH; i++) {
+				for (int j = 0; j < worldWords; j++)
+					worldWordsData[(i * worldWords) + j] = wolfEngine.getWorldWord(i, j);
+			}
+			std::string packed = packUint64Array(worldWordsData.data(), worldWordsData.size());
+			json_object_set_new(rootJ, "wolfWorldBuffer", json_string(packed.c_str()));
+		}
+
+		// Save Wolf reversible state, the row before the current one
+		json_object_set_new(rootJ, "wolfReversible", json_boolean(wolfReversible));
+		uint64_t previousWords[WolfEngine::MAX_WORLD_WORDS];
+		for (int i = 0; i < WolfEngine::MAX_WORLD_WORDS; i++)
+			previousWords[i] = wolfEngine.getPreviousWord(i);
+		std::string packedPrevious = packUint64Array(previousWords, WolfEngine::MAX_WORLD_WORDS);
+		json_object_set_new(rootJ, "wolfPrevious", json_string(packedPrevious.c_str()));
+
+		// Save Life large world, every frame of the sequence
+		json_object_set_new(rootJ, "lifeWorld", json_integer(lifeWorldIndex));
+		json_object_set_new(rootJ, "lifeCustomRule", json_string(lifeCustomRule.c_str()));
+		json_object_set_new(rootJ, "lifeRuleB", json_integer(lifeRuleB));
+
+		// Bank and custom rules by label too, the bank can change between sessions
+		char lifeRuleLabel[5];
+		LifeEngine::getBankRuleLabel(lifeEngine.getRuleSelect(), lifeRuleLabel);
+		json_object_set_new(rootJ, "lifeRuleLabel", json_string(lifeRuleLabel));
+		LifeEngine::getBankRuleLabel(lifeRuleB, lifeRuleLabel);
+		json_object_set_new(rootJ, "lifeRuleBLabel", json_string(lifeRuleLabel));
+		json_object_set_new(rootJ, "lifeRuleMask", json_integer(lifeRuleMaskIndex));
+		json_object_set_new(rootJ, "lifeInject", json_integer(lifeInjectIndex));
+		int worldSize = LifeEngine::worldSizes[lifeEngine.getWorldSize()];
+		if (worldSize > 8) {
+			std::vector<uint64_t> worldRows(MAX_SEQUENCE_LENGTH * worldSize);
+			for (int i = 0; i < MAX_SEQUENCE_LENGTH; i++) {
+				for (int j = 0; j < worldSize; j++)
+					worldRows[(i * worldSize) + j] = lifeEngine.getWorldRow(i, j);
+			}
+			std::string packed = packUint64Array(worldRows.data(), worldRows.size());
+			json_object_set_new(rootJ, "lifeWorldBuffer", json_string(packed.c_str()));
+		}
+
+		// Save Generations state planes, every frame of the sequence.
+		// Plane by plane so the frame deltas are small, skipped when empty
+		std::vector<uint64_t> generationsFrames(GenerationsEngine::NUM_PLANES * MAX_SEQUENCE_LENGTH);
+		for (int i = 0; i < GenerationsEngine::NUM_PLANES; i++) {
 			for (int j = 0; j < MAX_SEQUENCE_LENGTH; j++)
-				frames[j] = engine[i]->getBufferFrame(j);
-			std::string packed = packUint64Array(frames, MAX_SEQUENCE_LENGTH);
-			json_array_append_new(buffersJ, json_string(packed.c_str()));
+				generationsFrames[(i * MAX_SEQUENCE_LENGTH) + j] = generationsEngine.getFramePlane(j, i);
 		}
-		
-		json_object_set_new(rootJ, "readHeads", readHeadsJ);
-		json_object_set_new(rootJ, "writeHeads", writeHeadsJ);
-		json_object_set_new(rootJ, "rules", rulesJ);
-		json_object_set_new(rootJ, "seeds", seedsJ);
-		json_object_set_new(rootJ, "modes", modesJ);
-		json_object_set_new(rootJ, "displays", displaysJ);
-		json_object_set_new(rootJ, "buffers", buffersJ);
+		if (std::any_of(generationsFrames.begin(), generationsFrames.end(), [](uint64_t plane) { return plane != 0; }))
+			json_object_set_new(rootJ, "generationsFrames", json_string(packDeltaFrames(generationsFrames).c_str()));
+
+		// Save 3D Life volume, every layer of every frame.
+		// Layer by layer so the frame deltas are small, skipped when empty
+		std::vector<uint64_t> volumeFrames(VolumeEngine::NUM_LAYERS * MAX_SEQUENCE_LENGTH);
+		for (int i = 0; i < VolumeEngine::NUM_LAYERS; i++) {
+			for (int j = 0; j < MAX_SEQUENCE_LENGTH; j++)
+				volumeFrames[(i * MAX_SEQUENCE_LENGTH) + j] = volumeEngine.getFrameLayer(j, i);
+		}
+		if (std::any_of(volumeFrames.begin(), volumeFrames.end(), [](uint64_t layer) { return layer != 0; }))
+			json_object_set_new(rootJ, "volumeFrames", json_string(packDeltaFrames(volumeFrames).c_str()));
 		
 		return rootJ;
 	}
@@ -425,13 +930,77 @@ struct Wolfram : Module {
 		if (syncJ)
 			sync = json_boolean_value(syncJ);
 
+		json_t* cellProbabilityJ = json_object_get(rootJ, "cellProbability");
+		if (cellProbabilityJ)
+			cellProbability = json_boolean_value(cellProbabilityJ);
+
+		json_t* longLengthsJ = json_object_get(rootJ, "longLengths");
+		if (longLengthsJ)
+			longLengths = json_boolean_value(longLengthsJ);
+		wolfEngine.setHistoryDepth(getHistoryDepth());
+		lifeEngine.setHistoryDepth(getHistoryDepth());
+
 		json_t* audioRateModeJ = json_object_get(rootJ, "audioRateMode");
 		if (audioRateModeJ)
 			audioRateMode = json_boolean_value(audioRateModeJ);
 
+		json_t* oversampleJ = json_object_get(rootJ, "oversample");
+		if (oversampleJ)
+			oversampleIndex = rack::clamp(json_integer_value(oversampleJ), 0, NUM_OVERSAMPLE_FACTORS - 1);
+
+		json_t* fxJ = json_object_get(rootJ, "fx");
+		if (fxJ)
+			setFx(rack::clamp(json_integer_value(fxJ), 0, OutputFx::NUM_EFFECTS - 1));
+
+		// Patches from before the FX page had a linear slew (0 - 100%),
+		// SLEW at the same linear time replaces it, the Scale params become its amount
 		json_t* slewValueJ = json_object_get(rootJ, "slewValue");
-		if (slewValueJ)
-			setSlew(json_integer_value(slewValueJ));
+		if (slewValueJ && !fxJ) {
+			int slewValue = rack::clamp(static_cast<int>(json_integer_value(slewValueJ)), 0, 100);
+			if (slewValue > 0) {
+				setFx(OutputFx::SLEW);
+				float amount = 0.5f + (0.5f * slewValue * 0.01f);
+				params[X_SCALE_PARAM].setValue(amount);
+				params[Y_SCALE_PARAM].setValue(amount);
+			}
+		}
+
+		json_t* quantiserOutputsJ = json_object_get(rootJ, "quantiserOutputs");
+		if (quantiserOutputsJ)
+			quantiserOutputs = rack::clamp(json_integer_value(quantiserOutputsJ), 0, Quantiser::NUM_OUTPUTS - 1);
+
+		json_t* quantiserScaleJ = json_object_get(rootJ, "quantiserScale");
+		if (quantiserScaleJ)
+			quantiserScale = rack::clamp(json_integer_value(quantiserScaleJ), 0, Quantiser::NUM_SCALES - 1);
+
+		json_t* quantiserRootJ = json_object_get(rootJ, "quantiserRoot");
+		if (quantiserRootJ)
+			quantiserRoot = rack::clamp(json_integer_value(quantiserRootJ), 0, Quantiser::NUM_ROOTS - 1);
+
+		json_t* quantiserRangeJ = json_object_get(rootJ, "quantiserRange");
+		if (quantiserRangeJ)
+			quantiserRange = rack::clamp(json_integer_value(quantiserRangeJ), 0, Quantiser::NUM_RANGES - 1);
+
+		json_t* playheadsJ = json_object_get(rootJ, "playheads");
+		if (playheadsJ)
+			numPlayheads = rack::clamp(json_integer_value(playheadsJ), 0, MAX_PLAYHEADS);
+
+		json_t* playheadLengthsJ = json_object_get(rootJ, "playheadLengths");
+		json_t* playheadDelaysJ = json_object_get(rootJ, "playheadDelays");
+		for (int i = 0; i < MAX_PLAYHEADS; i++) {
+			if (playheadLengthsJ) {
+				json_t* valueJ = json_array_get(playheadLengthsJ, i);
+
+				if (valueJ)
+					playheadLengthIndex[i] = rack::clamp(json_integer_value(valueJ), 0, NUM_SEQUENCE_LENGTHS);
+			}
+			if (playheadDelaysJ) {
+				json_t* valueJ = json_array_get(playheadDelaysJ, i);
+
+				if (valueJ)
+					playheadDelayIndex[i] = rack::clamp(json_integer_value(valueJ), 0, NUM_PLAYHEAD_DELAYS - 1);
+			}
+		}
 
 		// Load engine selection
 		json_t* engineSelectJ = json_object_get(rootJ, "engine");
@@ -446,7 +1015,36 @@ struct Wolfram : Module {
 		if (cellStyleJ)
 			cellStyleIndex = rack::clamp(json_integer_value(cellStyleJ), 0, NUM_CELL_STYLES - 1);
 
-		// Load engine specifics
+		json_t* displayTransformJ = json_object_get(rootJ, "displayTransform");
+		if (displayTransformJ)
+			displayTransformIndex = rack::clamp(json_integer_value(displayTransformJ), 0, AlgoEngine::NUM_TRANSFORMS - 1);
+
+		json_t* displayRollJ = json_object_get(rootJ, "displayRoll");
+		if (displayRollJ)
+			displayRoll = rack::clamp(json_integer_value(displayRollJ), 0, 7);
+
+		// Custom Life rule before the rule selects, it extends the rule list
+		json_t* lifeCustomRuleJ = json_object_get(rootJ, "lifeCustomRule");
+		if (json_is_string(lifeCustomRuleJ))
+			setLifeCustomRule(json_string_value(lifeCustomRuleJ));
+
+		json_t* lifeRuleBJ = json_object_get(rootJ, "lifeRuleB");
+		if (lifeRuleBJ)
+			lifeRuleB = json_integer_value(lifeRuleBJ);
+
+		json_t* lifeRuleMaskJ = json_object_get(rootJ, "lifeRuleMask");
+		if (lifeRuleMaskJ)
+			lifeRuleMaskIndex = rack::clamp(json_integer_value(lifeRuleMaskJ), 0, LifeEngine::NUM_RULE_MASKS - 1);
+
+		json_t* lifeInjectJ = json_object_get(rootJ, "lifeInject");
+		if (lifeInjectJ)
+			lifeInjectIndex = rack::clamp(json_integer_value(lifeInjectJ), 0, LifeEngine::NUM_STAMPS);
+
+		// Load engine specifics, patches before engineState
+		// have them as per engine arrays
+		json_t* engineStateJ = json_object_get(rootJ, "engineState");
+		bool engineStateLoaded = json_is_string(engineStateJ) && unpackEngineState(json_string_value(engineStateJ));
+
 		json_t* rulesJ = json_object_get(rootJ, "rules");
 		json_t* seedsJ = json_object_get(rootJ, "seeds");
 		json_t* modesJ = json_object_get(rootJ, "modes");
@@ -455,7 +1053,7 @@ struct Wolfram : Module {
 		json_t* buffersJ = json_object_get(rootJ, "buffers");
 		json_t* displaysJ = json_object_get(rootJ, "displays");
 
-		for (int i = 0; i < NUM_ENGINES; i++) {
+		for (int i = 0; (i < NUM_ENGINES) && !engineStateLoaded; i++) {
 			if (readHeadsJ) {
 				json_t* valueJ = json_array_get(readHeadsJ, i);
 
@@ -504,17 +1102,147 @@ struct Wolfram : Module {
 					uint64_t matrixFrames[MAX_SEQUENCE_LENGTH];
 
 					unpackUint64Array(json_string_value(v), matrixFrames, MAX_SEQUENCE_LENGTH);
-
-					for (int j = 0; j < MAX_SEQUENCE_LENGTH; j++)
-						engine[i]->setBufferFrame(matrixFrames[j], j);
+					engine[i]->setBufferFrames(matrixFrames, MAX_SEQUENCE_LENGTH);
 				}	
 			}
 
 			engine[i]->updateDisplay(false);
 		}
+
+		// Life rules past the built-in ones are found again by label
+		json_t* lifeRuleLabelJ = json_object_get(rootJ, "lifeRuleLabel");
+		if (json_is_string(lifeRuleLabelJ))
+			lifeEngine.setRuleSelect(LifeEngine::findSavedRule(lifeEngine.getRuleSelect(), json_string_value(lifeRuleLabelJ)));
+
+		json_t* lifeRuleBLabelJ = json_object_get(rootJ, "lifeRuleBLabel");
+		if (json_is_string(lifeRuleBLabelJ))
+			lifeRuleB = LifeEngine::findSavedRule(lifeRuleB, json_string_value(lifeRuleBLabelJ));
+
+		// Load Wolf and Life long buffers, the first 64 frames are also in buffers
+		std::array<AlgoEngine*, 2> longEngines{ &wolfEngine, &lifeEngine };
+		std::array<const char*, 2> longKeys{ "wolfLongBuffer", "lifeLongBuffer" };
+		for (int i = 0; i < 2; i++) {
+			json_t* longBufferJ = json_object_get(rootJ, longKeys[i]);
+			if (!json_is_string(longBufferJ))
+				continue;
+
+			std::vector<uint64_t> frames(MAX_LONG_SEQUENCE_LENGTH);
+			unpackDeltaFrames(json_string_value(longBufferJ), frames);
+			longEngines[i]->setBufferFrames(frames.data(), frames.size());
+			longEngines[i]->updateDisplay(false);
+		}
+
+		// Load Wolf wide world
+		json_t* wolfWorldJ = json_object_get(rootJ, "wolfWorld");
+		if (wolfWorldJ) {
+			wolfWorldIndex = rack::clamp(json_integer_value(wolfWorldJ), 0, WolfEngine::NUM_WORLD_SIZES - 1);
+			wolfEngine.setWorldSize(wolfWorldIndex);
+		}
+
+		json_t* wolfWorldBufferJ = json_object_get(rootJ, "wolfWorldBuffer");
+		int worldWords = WolfEngine::worldSizes[wolfEngine.getWorldSize()] / 64;
+		if (json_is_string(wolfWorldBufferJ) && (worldWords > 0)) {
+			std::vector<uint64_t> worldWordsData(MAX_SEQUENCE_LENGTH * worldWords);
+			unpackUint64Array(json_string_value(wolfWorldBufferJ), worldWordsData.data(), worldWordsData.size());
+
+			for (int i = 0; i < MAX_SEQUENCE_LENGTH; i++) {
+				for (int j = 0; j < worldWords; j++)
+					wolfEngine.setWorldWord(worldWordsData[(i * worldWords) + j], i, j);
+			}
+			wolfEngine.updateDisplay(false);
+		}
+
+		// Load Wolf reversible state
+		json_t* wolfReversibleJ = json_object_get(rootJ, "wolfReversible");
+		if (wolfReversibleJ) {
+			wolfReversible = json_boolean_value(wolfReversibleJ);
+			wolfEngine.setReversible(wolfReversible);
+		}
+
+		json_t* wolfPreviousJ = json_object_get(rootJ, "wolfPrevious");
+		if (json_is_string(wolfPreviousJ)) {
+			uint64_t previousWords[WolfEngine::MAX_WORLD_WORDS];
+			unpackUint64Array(json_string_value(wolfPreviousJ), previousWords, WolfEngine::MAX_WORLD_WORDS);
+			for (int i = 0; i < WolfEngine::MAX_WORLD_WORDS; i++)
+				wolfEngine.setPreviousWord(previousWords[i], i);
+		}
+
+		// Load Life large world
+		json_t* lifeWorldJ = json_object_get(rootJ, "lifeWorld");
+		if (lifeWorldJ) {
+			lifeWorldIndex = rack::clamp(json_integer_value(lifeWorldJ), 0, LifeEngine::NUM_WORLD_SIZES - 1);
+			lifeEngine.setWorldSize(lifeWorldIndex);
+		}
+
+		json_t* lifeWorldBufferJ = json_object_get(rootJ, "lifeWorldBuffer");
+		int worldSize = LifeEngine::worldSizes[lifeEngine.getWorldSize()];
+		if (json_is_string(lifeWorldBufferJ) && (worldSize > 8)) {
+			std::vector<uint64_t> worldRows(MAX_SEQUENCE_LENGTH * worldSize);
+			unpackUint64Array(json_string_value(lifeWorldBufferJ), worldRows.data(), worldRows.size());
+
+			for (int i = 0; i < MAX_SEQUENCE_LENGTH; i++) {
+				for (int j = 0; j < worldSize; j++)
+					lifeEngine.setWorldRow(worldRows[(i * worldSize) + j], i, j);
+			}
+			lifeEngine.updateDisplay(false);
+		}
+
+		// Load Generations state planes, older patches have them as
+		// a hex array or only have the alive plane in buffers
+		json_t* generationsFramesJ = json_object_get(rootJ, "generationsFrames");
+		json_t* generationsPlanesJ = json_object_get(rootJ, "generationsPlanes");
+		if (json_is_string(generationsFramesJ)) {
+			std::vector<uint64_t> generationsFrames(GenerationsEngine::NUM_PLANES * MAX_SEQUENCE_LENGTH);
+			unpackDeltaFrames(json_string_value(generationsFramesJ), generationsFrames);
+
+			for (int i = 0; i < GenerationsEngine::NUM_PLANES; i++) {
+				for (int j = 0; j < MAX_SEQUENCE_LENGTH; j++)
+					generationsEngine.setFramePlane(generationsFrames[(i * MAX_SEQUENCE_LENGTH) + j], j, i);
+			}
+			generationsEngine.updateDisplay(false);
+		}
+		else if (json_is_string(generationsPlanesJ)) {
+			std::vector<uint64_t> generationsPlanes(MAX_SEQUENCE_LENGTH * GenerationsEngine::NUM_PLANES);
+			unpackUint64Array(json_string_value(generationsPlanesJ), generationsPlanes.data(), generationsPlanes.size());
+
+			for (int i = 0; i < MAX_SEQUENCE_LENGTH; i++) {
+				for (int j = 0; j < GenerationsEngine::NUM_PLANES; j++)
+					generationsEngine.setFramePlane(generationsPlanes[(i * GenerationsEngine::NUM_PLANES) + j], i, j);
+			}
+			generationsEngine.updateDisplay(false);
+		}
+
+		// Load 3D Life volume, older patches have it as a hex array
+		json_t* volumeFramesJ = json_object_get(rootJ, "volumeFrames");
+		json_t* volumeBufferJ = json_object_get(rootJ, "volumeBuffer");
+		if (json_is_string(volumeFramesJ)) {
+			std::vector<uint64_t> volumeFrames(VolumeEngine::NUM_LAYERS * MAX_SEQUENCE_LENGTH);
+			unpackDeltaFrames(json_string_value(volumeFramesJ), volumeFrames);
+
+			for (int i = 0; i < VolumeEngine::NUM_LAYERS; i++) {
+				for (int j = 0; j < MAX_SEQUENCE_LENGTH; j++)
+					volumeEngine.setFrameLayer(volumeFrames[(i * MAX_SEQUENCE_LENGTH) + j], j, i);
+			}
+			volumeEngine.updateDisplay(false);
+		}
+		else if (json_is_string(volumeBufferJ)) {
+			std::vector<uint64_t> volumeLayers(MAX_SEQUENCE_LENGTH * VolumeEngine::NUM_LAYERS);
+			unpackUint64Array(json_string_value(volumeBufferJ), volumeLayers.data(), volumeLayers.size());
+
+			for (int i = 0; i < MAX_SEQUENCE_LENGTH; i++) {
+				for (int j = 0; j < VolumeEngine::NUM_LAYERS; j++)
+					volumeEngine.setFrameLayer(volumeLayers[(i * VolumeEngine::NUM_LAYERS) + j], i, j);
+			}
+			volumeEngine.updateDisplay(false);
+		}
+
+		updateEngineSettings();
 	}
 	
 	void process(const ProcessArgs& args) override {
+		if ((args.frame % UI_COMMAND_INTERVAL) == 0)
+			applyCommands();
+
 		// TODO: used AlgoEngine* activeEngine = engine[engineIndex],
 		// same with engineMenuParams maybe.
 		// TODO: currently encoderReset and miniMenuChange are used for the same seed reset,
@@ -535,13 +1263,31 @@ struct Wolfram : Module {
 			}
 		}
 
+		// Oversampling
+		int targetOversampleIndex = audioRateMode ? oversampleIndex : 0;
+		if (targetOversampleIndex != activeOversampleIndex)
+			setOversample(targetOversampleIndex);
+		int oversample = getOversample();
+
 		// Step
 		bool step = false;
+		std::array<bool, MAX_OVERSAMPLE> subSteps{};
 		float stepVoltage = inputs[TRIG_INPUT].getVoltage();
-		if (audioRateMode)	// Zero crossing
-			step = (stepVoltage > 0.f && prevStepVoltage <= 0.f) || (stepVoltage < 0.f && prevStepVoltage >= 0.f);
-		else				// Pulse trigger	
+		if (audioRateMode) {
+			// Zero crossing, detected on the linearly interpolated trigger input
+			float subStepVoltage = prevStepVoltage;
+			for (int i = 0; i < oversample; i++) {
+				float nextSubStepVoltage = prevStepVoltage + (stepVoltage - prevStepVoltage) * (i + 1) / oversample;
+				subSteps[i] = (nextSubStepVoltage > 0.f && subStepVoltage <= 0.f) || (nextSubStepVoltage < 0.f && subStepVoltage >= 0.f);
+				subStepVoltage = nextSubStepVoltage;
+				step |= subSteps[i];
+			}
+		}
+		else {
+			// Pulse trigger
 			step = trigTrigger.process(stepVoltage, 0.1f, 2.f);
+			subSteps[0] = step;
+		}
 		prevStepVoltage = stepVoltage;
 		// Engine
 		engineModulation = inputs[ENGINE_CV_INPUT].isConnected();
@@ -551,7 +1297,6 @@ struct Wolfram : Module {
 			syncedEngineCv = newEngineCv;
 		setEngine(engineSelect, sync ? syncedEngineCv : newEngineCv);
 
-		engineCoreParams[engineIndex].step = step;
 		// Rule 
 		ruleModulation = inputs[RULE_CV_INPUT].isConnected();
 		float ruleCvVoltage = inputs[RULE_CV_INPUT].getVoltage();
@@ -564,18 +1309,47 @@ struct Wolfram : Module {
 		// Length
 		int lengthValue = static_cast<int>(params[LENGTH_PARAM].getValue());
 		size_t lengthIndex = rack::clamp(lengthValue, 0, NUM_SEQUENCE_LENGTHS - 1);
-		sequenceLength = sequenceLengths[lengthIndex];
+		const auto& activeLengths = longLengths ? longSequenceLengths : sequenceLengths;
+		sequenceLength = activeLengths[lengthIndex];
 		engineCoreParams[engineIndex].length = sequenceLength;
 		// Probability
 		float probabilityCvVoltage = inputs[PROBABILITY_CV_INPUT].getVoltage();
 		float probabilityCv = probabilityCvVoltage * 0.1f;
 		float probabilityValue = params[PROBABILITY_PARAM].getValue();
 		engineCoreParams[engineIndex].probability = rack::clamp(probabilityValue + probabilityCv, 0.f, 1.f);
+		engineCoreParams[engineIndex].cellProbability = cellProbability;
 		// Offset
 		float offsetCvVoltage = inputs[OFFSET_CV_INPUT].getVoltage();
 		int offsetCv = static_cast<int>(std::round(offsetCvVoltage * 7.f * 0.1f));
 		int offsetValue = static_cast<int>(params[OFFSET_PARAM].getValue());
 		engineCoreParams[engineIndex].offset = rack::clamp(offsetValue + offsetCv, 0, 7);
+		// World view, from the expander
+		Module* expander = rightExpander.module;
+		bool expanderConnected = expander && (expander->model == modelWolframExpander);
+		auto* expanderMessage = static_cast<ExpanderToWolframMessage*>(rightExpander.consumerMessage);
+		engineCoreParams[engineIndex].viewOffset = expanderConnected ? expanderMessage->viewOffset : 0.f;
+		engineCoreParams[engineIndex].reverse = expanderConnected && expanderMessage->reverse;
+		engineCoreParams[engineIndex].scrub = expanderConnected ? expanderMessage->scrub : 0.f;
+		// Display transform, menu setting moved by the expander's transform CV
+		float transformCv = expanderConnected ? expanderMessage->transform : 0.f;
+		int transform = displayTransformIndex + static_cast<int>(std::round(transformCv * (AlgoEngine::NUM_TRANSFORMS - 1)));
+		engineCoreParams[engineIndex].transform = transform % AlgoEngine::NUM_TRANSFORMS;
+		engineCoreParams[engineIndex].roll = displayRoll;
+		// Stamp position, X from OFFSET moved by the expander's stamp CVs
+		float stampXCv = expanderConnected ? expanderMessage->stampX : 0.f;
+		float stampYCv = expanderConnected ? expanderMessage->stampY : 0.f;
+		engineCoreParams[engineIndex].stampX = (engineCoreParams[engineIndex].offset + static_cast<int>(std::round(stampXCv * 7.f)) + 8) % 8;
+		engineCoreParams[engineIndex].stampY = (static_cast<int>(std::round(stampYCv * 7.f)) + 8) % 8;
+		// Life rule mask, the engine mask follows the Wolf display
+		if (lifeRuleMaskIndex == LifeEngine::RULE_MASK_ENGINE)
+			lifeEngine.setRuleMask(lifeRuleMaskIndex, wolfEngine.getBufferFrame(0, true));
+		// Extra playheads
+		engineCoreParams[engineIndex].numPlayheads = numPlayheads;
+		for (int i = 0; i < MAX_PLAYHEADS; i++) {
+			int playheadLength = playheadLengthIndex[i];
+			engineCoreParams[engineIndex].playheadLength[i] = playheadLength ? activeLengths[playheadLength - 1] : 0;
+			engineCoreParams[engineIndex].playheadDelay[i] = playheadDelays[playheadDelayIndex[i]];
+		}
 
 		// Menu
 		if (menuTrigger.process(params[MENU_PARAM].getValue()))
@@ -615,8 +1389,8 @@ struct Wolfram : Module {
 						break;
 					}
 					case 2: {
-						// Slew page
-						setSlew(encoderReset ? 0 : (slewValue + delta));
+						// FX page
+						setFx(encoderReset ? OutputFx::effectDefault : (fxIndex + delta));
 						break;
 					}
 					case 3: {
@@ -658,17 +1432,45 @@ struct Wolfram : Module {
 		// OUTPUTS
 		float xCv = 0.f;
 		float yCv = 0.f;
-		bool xBit = false;
-		bool yBit = false;
-		float modeLED = 0.f;
+		EngineOutput engineOutput;
 	
-		for (int i = 0; i < NUM_ENGINES; i++)
-			engine[i]->updateMenuParams(engineMenuParams[i]);
+		engines.forEach([&](auto& e, int i) { e.updateMenuParams(engineMenuParams[i]); });
+
+		// Quantiser, tables are rebuilt by the settings commands
+		bool quantiseX = (quantiserOutputs == Quantiser::OUTPUTS_X) || (quantiserOutputs == Quantiser::OUTPUTS_XY);
+		bool quantiseY = (quantiserOutputs == Quantiser::OUTPUTS_Y) || (quantiserOutputs == Quantiser::OUTPUTS_XY);
 
-		engine[engineIndex]->process(engineCoreParams[engineIndex], &xCv, &yCv, &xBit, &yBit, &modeLED);
+		// FX amount, quantised outputs skip GAIN to stay in tune
+		float xScaleValue = params[X_SCALE_PARAM].getValue();
+		float yScaleValue = params[Y_SCALE_PARAM].getValue();
+		bool gain = (fxIndex == OutputFx::GAIN);
+		outputFx.setAmount(0, (gain && quantiseX) ? 1.f : xScaleValue, srate * oversample, audioRateMode);
+		outputFx.setAmount(1, (gain && quantiseY) ? 1.f : yScaleValue, srate * oversample, audioRateMode);
+
+		// Engine and FX run once per sub step,
+		// one shot events are only passed to the first
+		EngineCoreParams& coreParams = engineCoreParams[engineIndex];
+		visitEngine(engineIndex, [&](auto& activeEngine) {
+			for (int i = 0; i < oversample; i++) {
+				coreParams.step = subSteps[i];
+				activeEngine.process(coreParams, engineOutput);
+
+				xCv = quantiseX ? quantiser.process(engineOutput.xIndex, engineOutput.xLevels) : engineOutput.x;
+				yCv = quantiseY ? quantiser.process(engineOutput.yIndex, engineOutput.yLevels) : engineOutput.y;
+
+				float fxBuffer[2] = { xCv, yCv };
+				outputFx.process(fxBuffer);
+				oversampleBuffer[0][i] = fxBuffer[0];
+				oversampleBuffer[1][i] = fxBuffer[1];
+
+				coreParams.reset = false;
+				coreParams.inject = 0;
+				coreParams.miniMenuChanged = false;
+			}
+		});
 
-		xCv = slewLimiter[0].process(xCv);
-		yCv = slewLimiter[1].process(yCv);
+		xCv = decimator[0].process(oversampleBuffer[0].data());
+		yCv = decimator[1].process(oversampleBuffer[1].data());
 
 		float xAudio = xCv - 0.5f;
 		float yAudio = yCv - 0.5f;
@@ -680,17 +1482,30 @@ struct Wolfram : Module {
 		// CV outputs - 0V to 10V or -5V to 5V in Audio Rate Mode (10Vpp)
 		float xOut = audioRateMode ? xAudio : xCv;
 		float yOut = audioRateMode ? yAudio : yCv;
-		float xScaleValue = params[X_SCALE_PARAM].getValue();
-		float yScaleValue = params[Y_SCALE_PARAM].getValue();
-		xOut = xOut * xScaleValue * 10.f;
-		yOut = yOut * yScaleValue * 10.f;
+		xOut *= 10.f;
+		yOut *= 10.f;
 		outputs[X_OUTPUT].setVoltage(xOut);
 		outputs[Y_OUTPUT].setVoltage(yOut);
 
+		// Extra playheads, polyphonic channels 2 onwards.
+		// They skip the FX and DC filter, only GAIN scales them
+		outputs[X_OUTPUT].setChannels(numPlayheads + 1);
+		outputs[Y_OUTPUT].setChannels(numPlayheads + 1);
+		float xPlayheadScale = (gain && !quantiseX) ? xScaleValue : 1.f;
+		float yPlayheadScale = (gain && !quantiseY) ? yScaleValue : 1.f;
+		float playheadBias = audioRateMode ? 0.5f : 0.f;
+		for (int i = 0; i < numPlayheads; i++) {
+			const PlayheadOutput& playhead = engineOutput.playhead[i];
+			float xPlayhead = quantiseX ? quantiser.process(playhead.xIndex, engineOutput.xLevels) : playhead.x;
+			float yPlayhead = quantiseY ? quantiser.process(playhead.yIndex, engineOutput.yLevels) : playhead.y;
+			outputs[X_OUTPUT].setVoltage(((xPlayhead * xPlayheadScale) - playheadBias) * 10.f, i + 1);
+			outputs[Y_OUTPUT].setVoltage(((yPlayhead * yPlayheadScale) - playheadBias) * 10.f, i + 1);
+		}
+
 		// Pulse outputs (0V to 10V)
-		if (xBit)
+		if (engineOutput.xPulse)
 			xPulse.trigger(audioRateMode ? args.sampleTime : 1e-3f);
-		if (yBit)
+		if (engineOutput.yPulse)
 			yPulse.trigger(audioRateMode ? args.sampleTime : 1e-3f);
 
 		bool xGate = xPulse.process(args.sampleTime);
@@ -699,7 +1514,7 @@ struct Wolfram : Module {
 		outputs[Y_PULSE_OUTPUT].setVoltage(yGate ? 10.f : 0.f);
 
 		// LIGHTS
-		lights[MODE_LIGHT].setBrightnessSmooth(modeLED, args.sampleTime);
+		lights[MODE_LIGHT].setBrightnessSmooth(engineOutput.modeLED, args.sampleTime);
 		lights[X_LIGHT].setBrightness(xOut * 0.1f);
 		lights[Y_LIGHT].setBrightness(yOut * 0.1f);
 		lights[X_PULSE_LIGHT].setBrightnessSmooth(xGate, args.sampleTime);
@@ -709,6 +1524,13 @@ struct Wolfram : Module {
 		if (miniMenuActive && (ruleDisplayTimer.process(args.sampleTime) >= MINI_MENU_DISPLAY_TIME))
 			miniMenuActive = false;
 
+		// Expander
+		if (expanderConnected) {
+			auto* message = static_cast<WolframToExpanderMessage*>(expander->leftExpander.producerMessage);
+			message->matrix = engineOutput.matrix;
+			expander->leftExpander.requestMessageFlip();
+		}
+
 		if (((args.frame + this->id) % ENGINE_TO_UI_UPDATE_INTERVAL) == 0)
 			updateEngineToUiLayer();
 	}
@@ -1009,11 +1831,10 @@ struct Display : TransparentWidget {
 					break;
 				}
 				case 2: {
-					// Slew page
-					std::copy("SLEW", "SLEW" + 4, title);
-					char slewString[5]{};
-					snprintf(slewString, sizeof(slewString), "%3d%%", module->slewValue);
-					std::copy(slewString, slewString + 4, value);
+					// FX page
+					std::copy(" FX ", " FX " + 4, title);
+					std::copy(OutputFx::effectLabel[module->fxIndex],
+						OutputFx::effectLabel[module->fxIndex] + 4, value);
 					break;
 				}
 				case 3: {
@@ -1148,7 +1969,36 @@ struct WolframModuleWidget : ModuleWidget {
 		void onDoubleClick(const DoubleClickEvent& e) override {
 			// Reset Select encoder to default of current selection
 			auto* m = static_cast<Wolfram*>(module);
-			m->encoderReset = true;
+			m->pushCommand(Wolfram::UiCommand::ENCODER_RESET);
+		}
+	};
+
+	struct LifeRuleField : ui::TextField {
+		// Rule string entry, Enter compiles and applies it
+		Wolfram* module;
+
+		LifeRuleField(Wolfram* m) {
+			module = m;
+			box.size.x = 120.f;
+			multiline = false;
+			placeholder = "B3/S23";
+			text = module->lifeCustomRule;
+		}
+
+		void onSelectKey(const SelectKeyEvent& e) override {
+			if ((e.action == GLFW_PRESS) && ((e.key == GLFW_KEY_ENTER) || (e.key == GLFW_KEY_KP_ENTER))) {
+				if (module->setLifeCustomRule(text)) {
+					ui::MenuOverlay* overlay = getAncestorOfType<ui::MenuOverlay>();
+					if (overlay)
+						overlay->requestDelete();
+				}
+				else {
+					selectAll();
+				}
+				e.consume(this);
+				return;
+			}
+			ui::TextField::onSelectKey(e);
 		}
 	};
 
@@ -1276,29 +2126,254 @@ struct WolframModuleWidget : ModuleWidget {
 		addChild(display);
 	}
 	
+	void step() override {
+		auto* module = dynamic_cast<Wolfram*>(this->module);
+		if (module) {
+			module->updateHistoryDepth();
+			module->updateLifeCustomRule();
+		}
+		ModuleWidget::step();
+	}
+
 	void appendContextMenu(Menu* menu) override {
 		Wolfram* module = dynamic_cast<Wolfram*>(this->module);
 		
 		menu->addChild(new MenuSeparator);
 		menu->addChild(createIndexSubmenuItem("Algorithm",
-			{ "Wolf", "Life" },
+			Engines::getMenuNames(),
 			[=]() {
 				return module->engineSelect;
 			},
 			[=](int i) {
-				module->engineSelect = i;
+				module->pushCommand(Wolfram::UiCommand::ENGINE_SELECT, i);
 			}
 		));
 
-		menu->addChild(createBoolPtrMenuItem("Sync", "", &module->sync));
+		menu->addChild(createBoolMenuItem("Sync", "",
+			[=]() {
+				return module->sync;
+			},
+			[=](bool sync) {
+				module->pushCommand(Wolfram::UiCommand::SYNC, sync);
+			}
+		));
+		menu->addChild(createBoolMenuItem("Per cell probability", "",
+			[=]() {
+				return module->cellProbability;
+			},
+			[=](bool cellProbability) {
+				module->pushCommand(Wolfram::UiCommand::CELL_PROBABILITY, cellProbability);
+			}
+		));
+		menu->addChild(createBoolMenuItem("Long lengths", "Wolf & Life 8x8",
+			[=]() {
+				return module->longLengths;
+			},
+			[=](bool longLengths) {
+				module->pushCommand(Wolfram::UiCommand::LONG_LENGTHS, longLengths);
+			}
+		));
 	
 		menu->addChild(createBoolMenuItem("Audio Rate", "",
 			[=]() {
 				return module->audioRateMode;
 			},
 			[=](bool audioRateMode) {
-				module->audioRateMode = audioRateMode;
-				module->onSampleRateChange();
+				module->pushCommand(Wolfram::UiCommand::AUDIO_RATE, audioRateMode);
+			}
+		));
+
+		menu->addChild(createIndexSubmenuItem("Oversampling",
+			{ "Off", "2x", "4x", "8x" },
+			[=]() {
+				return module->oversampleIndex;
+			},
+			[=](int i) {
+				module->pushCommand(Wolfram::UiCommand::OVERSAMPLE, i);
+			},
+			!module->audioRateMode
+		));
+
+		menu->addChild(createSubmenuItem("Quantiser", "",
+			[=](Menu* menu) {
+				menu->addChild(createIndexSubmenuItem("Outputs",
+					{ "Off", "X", "Y", "X & Y" },
+					[=]() {
+						return module->quantiserOutputs;
+					},
+					[=](int i) {
+						module->pushCommand(Wolfram::UiCommand::QUANTISER_OUTPUTS, i);
+					}
+				));
+
+				std::vector<std::string> scaleNames;
+				for (const Quantiser::Scale& scale : Quantiser::scale)
+					scaleNames.push_back(scale.name);
+
+				menu->addChild(createIndexSubmenuItem("Scale", scaleNames,
+					[=]() {
+						return module->quantiserScale;
+					},
+					[=](int i) {
+						module->pushCommand(Wolfram::UiCommand::QUANTISER_SCALE, i);
+					}
+				));
+
+				std::vector<std::string> rootNames(std::begin(Quantiser::rootName), std::end(Quantiser::rootName));
+				menu->addChild(createIndexSubmenuItem("Root", rootNames,
+					[=]() {
+						return module->quantiserRoot;
+					},
+					[=](int i) {
+						module->pushCommand(Wolfram::UiCommand::QUANTISER_ROOT, i);
+					}
+				));
+
+				menu->addChild(createIndexSubmenuItem("Range",
+					{ "1 octave", "2 octaves", "3 octaves", "4 octaves", "5 octaves" },
+					[=]() {
+						return module->quantiserRange;
+					},
+					[=](int i) {
+						module->pushCommand(Wolfram::UiCommand::QUANTISER_RANGE, i);
+					}
+				));
+			}
+		));
+
+		menu->addChild(createIndexSubmenuItem("Wolf world",
+			{ "8 cells", "64 cells", "128 cells", "256 cells" },
+			[=]() {
+				return module->wolfWorldIndex;
+			},
+			[=](int i) {
+				module->pushCommand(Wolfram::UiCommand::WOLF_WORLD, i);
+			}
+		));
+
+		menu->addChild(createBoolMenuItem("Wolf reversible", "",
+			[=]() {
+				return module->wolfReversible;
+			},
+			[=](bool wolfReversible) {
+				module->pushCommand(Wolfram::UiCommand::WOLF_REVERSIBLE, wolfReversible);
+			}
+		));
+
+		menu->addChild(createIndexSubmenuItem("Life world",
+			{ "8x8", "16x16", "32x32", "64x64" },
+			[=]() {
+				return module->lifeWorldIndex;
+			},
+			[=](int i) {
+				module->pushCommand(Wolfram::UiCommand::LIFE_WORLD, i);
+			}
+		));
+
+		menu->addChild(createSubmenuItem("Life custom rule", module->lifeCustomRule,
+			[=](Menu* menu) {
+				menu->addChild(createMenuLabel("B/S or Hensel notation, Enter to apply"));
+				menu->addChild(new LifeRuleField(module));
+			}
+		));
+
+		std::vector<std::string> injectNames = { "Random cells" };
+		for (int i = 0; i < LifeEngine::NUM_STAMPS; i++) {
+			char label[5];
+			LifeEngine::getStampLabel(i, label);
+			injectNames.push_back(std::string("Stamp ") + label);
+		}
+		menu->addChild(createIndexSubmenuItem("Life inject", injectNames,
+			[=]() {
+				return module->lifeInjectIndex;
+			},
+			[=](int i) {
+				module->pushCommand(Wolfram::UiCommand::LIFE_INJECT, i);
+			}
+		));
+
+		menu->addChild(createSubmenuItem("Life rule B", "",
+			[=](Menu* menu) {
+				menu->addChild(createIndexSubmenuItem("Region",
+					{ "Off", "Side by side", "Top & bottom", "Checkerboard", "2x2 checkerboard", "Centre & border", "Wolf display" },
+					[=]() {
+						return module->lifeRuleMaskIndex;
+					},
+					[=](int i) {
+						module->pushCommand(Wolfram::UiCommand::LIFE_RULE_MASK, i);
+					}
+				));
+
+				// Rule A runs inside the region, rule B outside it
+				std::vector<std::string> ruleNames;
+				int numRules = LifeEngine::getNumBankRules() + (module->lifeCustomRule.empty() ? 0 : 1);
+				for (int i = 0; i < numRules; i++) {
+					char label[5];
+					LifeEngine::getBankRuleLabel(i, label);
+					ruleNames.push_back(label);
+				}
+				menu->addChild(createIndexSubmenuItem("Rule B", ruleNames,
+					[=]() {
+						return module->lifeRuleB;
+					},
+					[=](int i) {
+						module->pushCommand(Wolfram::UiCommand::LIFE_RULE_B, i);
+					}
+				));
+			}
+		));
+
+		menu->addChild(createSubmenuItem("Playheads", "",
+			[=](Menu* menu) {
+				menu->addChild(createIndexSubmenuItem("Extra playheads",
+					{ "None", "1", "2", "3", "4", "5", "6", "7" },
+					[=]() {
+						return module->numPlayheads;
+					},
+					[=](int i) {
+						module->pushCommand(Wolfram::UiCommand::NUM_PLAYHEADS, i);
+					}
+				));
+
+				// Playheads loop within the main loop, so only
+				// lengths up to the main length are offered
+				std::vector<std::string> lengthNames = { "Main" };
+				for (size_t length : (module->longLengths ? module->longSequenceLengths : module->sequenceLengths)) {
+					if (length <= module->sequenceLength)
+						lengthNames.push_back(std::to_string(length));
+				}
+
+				std::vector<std::string> delayNames;
+				for (size_t delay : module->playheadDelays)
+					delayNames.push_back(std::to_string(delay));
+
+				if (module->numPlayheads > 0)
+					menu->addChild(createMenuLabel("Lengths stop at the main length"));
+
+				for (int i = 0; i < module->numPlayheads; i++) {
+					menu->addChild(new MenuSeparator);
+					menu->addChild(createMenuLabel(string::f("Playhead %d (channel %d)", i + 1, i + 2)));
+
+					// A length past the main length plays the main length
+					int lastLength = static_cast<int>(lengthNames.size()) - 1;
+					menu->addChild(createIndexSubmenuItem("Length", lengthNames,
+						[=]() {
+							return std::min(module->playheadLengthIndex[i], lastLength);
+						},
+						[=](int j) {
+							module->pushCommand(Wolfram::UiCommand::PLAYHEAD_LENGTH, j, i);
+						}
+					));
+
+					menu->addChild(createIndexSubmenuItem("Delay", delayNames,
+						[=]() {
+							return module->playheadDelayIndex[i];
+						},
+						[=](int j) {
+							module->pushCommand(Wolfram::UiCommand::PLAYHEAD_DELAY, j, i);
+						}
+					));
+				}
 			}
 		));
 
@@ -1309,7 +2384,7 @@ struct WolframModuleWidget : ModuleWidget {
 				return module->displayStyleIndex;
 			},
 			[=](int i) {
-				module->displayStyleIndex = i;
+				module->pushCommand(Wolfram::UiCommand::DISPLAY_STYLE, i);
 			} 
 		));
 
@@ -1319,7 +2394,27 @@ struct WolframModuleWidget : ModuleWidget {
 				return module->cellStyleIndex;
 			},
 			[=](int i) {
-				module->cellStyleIndex = i;
+				module->pushCommand(Wolfram::UiCommand::CELL_STYLE, i);
+			}
+		));
+
+		menu->addChild(createIndexSubmenuItem("Transform",
+			{ "None", "Mirror X", "Mirror Y", "Rotate 90", "Rotate 180", "Rotate 270", "Transpose", "Anti-transpose" },
+			[=]() {
+				return module->displayTransformIndex;
+			},
+			[=](int i) {
+				module->pushCommand(Wolfram::UiCommand::DISPLAY_TRANSFORM, i);
+			}
+		));
+
+		menu->addChild(createIndexSubmenuItem("Roll",
+			{ "0", "1", "2", "3", "4", "5", "6", "7" },
+			[=]() {
+				return module->displayRoll;
+			},
+			[=](int i) {
+				module->pushCommand(Wolfram::UiCommand::DISPLAY_ROLL, i);
 			}
 		));
 	}
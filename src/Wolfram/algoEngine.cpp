@@ -13,14 +13,25 @@ AlgoEngine::~AlgoEngine() = default;
 
 // Setters
 void AlgoEngine::setReadHead(size_t newReadHead) {
-    readHead = rack::clamp(newReadHead, 0, MAX_SEQUENCE_LENGTH - 1);
+    readHead = rack::clamp(static_cast<int>(newReadHead), 0, static_cast<int>(maxLength) - 1);
+    playheadCounter.fill(readHead);
 }
 
 void AlgoEngine::setWriteHead(size_t newWriteHead) {
-    writeHead = rack::clamp(newWriteHead, 0, MAX_SEQUENCE_LENGTH - 1);
+    writeHead = rack::clamp(static_cast<int>(newWriteHead), 0, static_cast<int>(maxLength) - 1);
+}
+
+void AlgoEngine::setBufferFrames(const uint64_t* frames, size_t count) {
+    for (size_t i = 0; i < count; i++)
+        setBufferFrame(frames[i], static_cast<int>(i));
 }
 
 // Getters
+void AlgoEngine::getBufferFrames(uint64_t* frames, size_t count) {
+    for (size_t i = 0; i < count; i++)
+        frames[i] = getBufferFrame(static_cast<int>(i));
+}
+
 int AlgoEngine::getReadHead() {
     return static_cast<int>(readHead);
 }
@@ -34,6 +45,16 @@ void AlgoEngine::getEngineLabel(char out[5]) {
 }
 
 // Helpers
+void AlgoEngine::setMaxLength(size_t newMaxLength) {
+    // Heads past a shorter buffer wrap back into it
+    maxLength = newMaxLength;
+    readHead %= maxLength;
+    writeHead %= maxLength;
+    for (size_t& counter : playheadCounter)
+        counter %= maxLength;
+    playheadsDirty = true;
+}
+
 uint8_t AlgoEngine::applyOffset(uint8_t inputRow, int inputOffset) {
     int shift = inputOffset % 8;
     if (shift > 3)
@@ -49,3 +70,46 @@ uint8_t AlgoEngine::applyOffset(uint8_t inputRow, int inputOffset) {
     return inputRow;
 }
 
+uint8_t AlgoEngine::reverseRow(uint8_t row) {
+    row = ((row & 0xF0) >> 4) | ((row & 0x0F) << 4);
+    row = ((row & 0xCC) >> 2) | ((row & 0x33) << 2);
+    row = ((row & 0xAA) >> 1) | ((row & 0x55) << 1);
+    return row;
+}
+
+void AlgoEngine::getHorizontalNeighbours(uint8_t row, int edgeMode, uint8_t& west, uint8_t& east) {
+    if (edgeMode == 0) {
+        // Clip
+        west = row >> 1;
+        east = row << 1;
+    }
+    else if (edgeMode == 1 || edgeMode == 2) {
+        // Wrap & klein bottle
+        west = (row >> 1) | (row << 7);
+        east = (row << 1) | (row >> 7);
+    }
+    else if (edgeMode == 3) {
+        // Random
+        west = (row >> 1) | (rack::random::get<bool>() << 7);
+        east = (row << 1) | rack::random::get<bool>();
+    }
+}
+
+uint64_t AlgoEngine::getProbabilityMask(float probability) {
+    // Every bit set with the probability, to 1/256.
+    // From the lowest bit of the probability up, a set bit ORs in a random word
+    // and a clear bit ANDs one, each word halving the distance to the probability
+    int level = static_cast<int>(std::round(rack::clamp(probability, 0.f, 1.f) * 256.f));
+    if (level >= 256)
+        return UINT64_MAX;
+    if (level <= 0)
+        return 0;
+
+    uint64_t mask = 0;
+    for (int i = __builtin_ctz(level); i < 8; i++) {
+        uint64_t word = rack::random::get<uint64_t>();
+        mask = ((level >> i) & 1) ? (mask | word) : (mask & word);
+    }
+    return mask;
+}
+
@@ -8,8 +8,11 @@
 
 #pragma once
 #include "../plugin.hpp"
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstdint>
+#include <vector>
 
 // TODO:
 // - process() should be defined in algoEngine or in Wolfram module <- a better idea,
@@ -20,6 +23,8 @@
 // and could be called in constuctor to remove repeated code
 
 static constexpr int MAX_SEQUENCE_LENGTH = 64;
+static constexpr int MAX_LONG_SEQUENCE_LENGTH = 65536;	// Wolf and Life on their 8 cell boards
+static constexpr int MAX_PLAYHEADS = 7;	// Extra playheads, polyphonic channels 2 - 8
 
 struct EngineMenuParams {
 	enum MenuDeltas{
@@ -41,13 +46,48 @@ struct EngineMenuParams {
 struct EngineCoreParams {
 	float ruleCv = 0.f;
 	float probability = 0.f;
+	bool cellProbability = false;	// Every step generates, each cell updates with the probability
 	size_t length = 0;
 	int offset = 0;
+	float viewOffset = 0.f;	// -1 - 1, moves large world windows, from the expander
+	bool reverse = false;	// Runs reversible rules backwards, from the expander
+	float scrub = 0.f;		// 0 - 1, looks back through the loop, from the expander
+	int transform = 0;		// Display transform, AlgoEngine::DisplayTransform
+	int roll = 0;			// 0 - 7, rows the display is rotated up
+	int stampX = 0;			// 0 - 7, stamp inject position
+	int stampY = 0;
 	int inject = 0;
 	bool step = false;
 	bool reset = false;
 	bool sync = false;
 	bool miniMenuChanged = false;
+	// Extra playheads, a length of 0 follows the main length
+	int numPlayheads = 0;
+	std::array<size_t, MAX_PLAYHEADS> playheadLength{};
+	std::array<size_t, MAX_PLAYHEADS> playheadDelay{};
+};
+
+struct PlayheadOutput {
+	float x = 0.f;	// 0 - 1
+	float y = 0.f;
+	int xIndex = 0;
+	int yIndex = 0;
+};
+
+struct EngineOutput {
+	float x = 0.f;	// 0 - 1
+	float y = 0.f;
+	// Raw values behind X and Y (0 to levels - 1), 
+	// used to index the quantiser tables directly
+	int xIndex = 0;
+	int yIndex = 0;
+	int xLevels = 256;
+	int yLevels = 256;
+	bool xPulse = false;
+	bool yPulse = false;
+	float modeLED = 0.f;
+	uint64_t matrix = 0;	// Display matrix, for the expander
+	std::array<PlayheadOutput, MAX_PLAYHEADS> playhead{};
 };
 
 struct EngineToUiLayer {
@@ -62,18 +102,82 @@ struct EngineToUiLayer {
 	char modeLabel[5]{};
 };
 
+template <typename T>
+class HistoryBuffer {
+	// Sequence buffer sized to the history depth in use, so short
+	// sequences stay small and cache resident. A new depth is allocated
+	// by the UI thread with request(), swapped in by the audio thread
+	// with update() and the old buffer is freed by the UI with collect()
+public:
+	explicit HistoryBuffer(size_t depth) : active(depth) {}
+
+	inline T& operator[](size_t index) { return active[index]; }
+	inline const T& operator[](size_t index) const { return active[index]; }
+	inline size_t size() const { return active.size(); }
+	inline T* begin() { return active.data(); }
+	inline T* end() { return active.data() + active.size(); }
+
+	void resize(size_t depth) {
+		// Immediate, only when the audio thread is not running the engine
+		active.resize(depth);
+		pending = std::vector<T>();
+		state.store(IDLE, std::memory_order_relaxed);
+	}
+
+	void request(size_t depth) {
+		if ((state.load(std::memory_order_acquire) != IDLE) || (depth == active.size()))
+			return;
+		pending.assign(depth, T{});
+		state.store(READY, std::memory_order_release);
+	}
+
+	bool update() {
+		if (state.load(std::memory_order_acquire) != READY)
+			return false;
+		// Depths are 64 or 65,536 frames and a request for the current
+		// depth is ignored, so only the 64 frames both share are copied
+		std::copy_n(active.begin(), std::min(active.size(), pending.size()), pending.begin());
+		active.swap(pending);
+		state.store(RETIRED, std::memory_order_release);
+		return true;
+	}
+
+	void collect() {
+		if (state.load(std::memory_order_acquire) != RETIRED)
+			return;
+		pending = std::vector<T>();
+		state.store(IDLE, std::memory_order_release);
+	}
+
+private:
+	enum State { IDLE, READY, RETIRED };
+	std::vector<T> active;
+	std::vector<T> pending;
+	std::atomic<int> state{ IDLE };
+};
+
 class AlgoEngine {
 public:
 	AlgoEngine();
 	virtual ~AlgoEngine();
 
+	// Whole board symmetries, applied to the display before the outputs
+	enum DisplayTransform {
+		TRANSFORM_NONE,
+		MIRROR_X,
+		MIRROR_Y,
+		ROTATE_90,
+		ROTATE_180,
+		ROTATE_270,
+		TRANSPOSE,
+		ANTI_TRANSPOSE,
+		NUM_TRANSFORMS
+	};
+
 	virtual void updateDisplay(bool advance, size_t length = 8) = 0;
 	virtual void updateMenuParams(const EngineMenuParams& p) = 0;
 
-	virtual void process(const EngineCoreParams& p,
-		float* xOut, float* yOut, 
-		bool* xPulse, bool* yPulse, 
-		float* modeLED) = 0;
+	virtual void process(const EngineCoreParams& p, EngineOutput& out) = 0;
 
 	virtual void reset() = 0;
 
@@ -83,6 +187,8 @@ public:
 
 	virtual void setBufferFrame(uint64_t newFrame, int index, 
 		bool setDisplayMatrix = false) = 0;
+	// Bulk, frames 0 to count - 1, past the buffer are ignored
+	virtual void setBufferFrames(const uint64_t* frames, size_t count);
 
 	virtual void setRuleSelect(int newRule) = 0;
 	virtual void setRuleCv(float newRuleCv) = 0;
@@ -96,6 +202,8 @@ public:
 	virtual uint64_t getBufferFrame(int index,
 		bool getDisplayMatrix = false,
 		bool getDisplayMatrixSave = false) = 0;
+	// Bulk, frames past the buffer read as 0
+	virtual void getBufferFrames(uint64_t* frames, size_t count);
 
 	virtual int getRuleSelect() = 0;
 	virtual int getSeed() = 0;
@@ -114,6 +222,15 @@ protected:
 
 	size_t readHead = 0;
 	size_t	writeHead = 1;
+	size_t maxLength = MAX_SEQUENCE_LENGTH;	// Frames in the sequence buffer
+
+	// Scrub, the display and outputs show a frame behind the read head,
+	// generation carries on from the read head
+	size_t scrubOffset = 0;
+	size_t scrubLength = 1;
+
+	int displayTransform = TRANSFORM_NONE;
+	int displayRoll = 0;
 	int offset = 0;
 	int injectPending = 0;
 	bool resetPending = false;
@@ -121,18 +238,115 @@ protected:
 	bool seedResetPending = false;
 	char engineLabel[5] = "BASE";
 
+	// Extra playheads read the same buffer as the main read head,
+	// each counting through its own loop length, up to the main length
+	std::array<size_t, MAX_PLAYHEADS> playheadCounter{};
+	std::array<size_t, MAX_PLAYHEADS> playheadLength{};
+	bool playheadResetPending = false;
+
+	// Extra playhead outputs are cached and only rendered again
+	// when the display changes or a playhead setting does
+	std::array<PlayheadOutput, MAX_PLAYHEADS> playheadOutput{};
+	bool playheadsDirty = true;
+	int playheadCount = 0;
+	size_t playheadMainLength = 0;
+	std::array<size_t, MAX_PLAYHEADS> playheadDelay{};
+
 	virtual void inject(int inject, bool sync) = 0;
 	virtual void onRuleChange() = 0;
 
 	// Helpers
 	inline void advanceHeads(size_t length) {
+		length = std::min(length, maxLength);
 		readHead = writeHead;
 		writeHead += 1;
 
 		if (writeHead >= length)
 			writeHead = 0;
+
+		// Frames past the main length are not in the loop,
+		// so longer playheads play the main length
+		for (int i = 0; i < MAX_PLAYHEADS; i++) {
+			size_t headLength = playheadLength[i] ? std::min(playheadLength[i], length) : length;
+			playheadCounter[i] = (playheadCounter[i] + 1) % headLength;
+		}
+
+		// Sync reset, extra playheads restart with the read head
+		if (playheadResetPending) {
+			playheadCounter = {};
+			playheadResetPending = false;
+		}
+	}
+
+	inline void setPlayheadLengths(const EngineCoreParams& p) {
+		playheadLength = p.playheadLength;
+	}
+
+	inline bool updatePlayheads(const EngineCoreParams& p) {
+		// True if the cached playhead outputs need rendering
+		bool changed = playheadsDirty || (p.numPlayheads != playheadCount)
+			|| (p.length != playheadMainLength) || (p.playheadDelay != playheadDelay);
+		playheadsDirty = false;
+		playheadCount = p.numPlayheads;
+		playheadMainLength = p.length;
+		playheadDelay = p.playheadDelay;
+		return changed;
+	}
+
+	inline void copyPlayheads(const EngineCoreParams& p, EngineOutput& out) {
+		std::copy_n(playheadOutput.begin(), p.numPlayheads, out.playhead.begin());
+	}
+
+	inline size_t getPlayheadFrame(const EngineCoreParams& p, int index) {
+		// Delay is counted back from the playhead's position in the main loop,
+		// equal lengths and a delay give a canon of the main output
+		size_t length = rack::clamp(static_cast<int>(p.length), 1, static_cast<int>(maxLength));
+		size_t delay = p.playheadDelay[index] % length;
+		return (playheadCounter[index] + length - delay) % length;
 	}
 	
+	inline bool updateScrub(const EngineCoreParams& p) {
+		// Every frame of the loop is in the buffer, so any scrub position is one index
+		size_t length = rack::clamp(static_cast<int>(p.length), 1, static_cast<int>(maxLength));
+		size_t newScrubOffset = static_cast<size_t>(std::round(rack::clamp(p.scrub, 0.f, 1.f) * (length - 1)));
+		bool changed = (newScrubOffset != scrubOffset) || (length != scrubLength);
+		scrubOffset = newScrubOffset;
+		scrubLength = length;
+		return changed;
+	}
+
+	inline bool updateTransform(const EngineCoreParams& p) {
+		int newTransform = rack::clamp(p.transform, 0, NUM_TRANSFORMS - 1);
+		int newRoll = p.roll & 7;
+		bool changed = (newTransform != displayTransform) || (newRoll != displayRoll);
+		displayTransform = newTransform;
+		displayRoll = newRoll;
+		return changed;
+	}
+
+	inline uint64_t transformDisplay(uint64_t matrix) {
+		// Roll rotates whole rows, then the board symmetry
+		if (displayRoll)
+			matrix = (matrix << (displayRoll * 8)) | (matrix >> (64 - (displayRoll * 8)));
+
+		switch (displayTransform) {
+			case MIRROR_X:			return mirrorRows(matrix);
+			case MIRROR_Y:			return __builtin_bswap64(matrix);
+			case ROTATE_90:			return mirrorRows(transposeMatrix(matrix));
+			case ROTATE_180:		return mirrorRows(__builtin_bswap64(matrix));
+			case ROTATE_270:		return __builtin_bswap64(transposeMatrix(matrix));
+			case TRANSPOSE:			return transposeMatrix(matrix);
+			case ANTI_TRANSPOSE:	return mirrorRows(__builtin_bswap64(transposeMatrix(matrix)));
+			default:				return matrix;
+		}
+	}
+
+	inline size_t getScrubHead() {
+		if (scrubOffset == 0)
+			return readHead;
+		return (readHead + scrubLength - scrubOffset) % scrubLength;
+	}
+
 	inline void resetHeads(bool read, bool write) {
 		if (read)
 			readHead = 0;
@@ -140,6 +354,11 @@ protected:
 			writeHead = 1;
 	}
 
+	inline void resetPlayheads() {
+		playheadCounter = {};
+		playheadResetPending = false;
+	}
+
 	inline int updateSelect(int delta, int reset,
 		int value, int defaultValue, int maxValue) {
 		if (reset)
@@ -148,5 +367,132 @@ protected:
 		return (value + delta + maxValue) % maxValue;
 	}
 
+	void setMaxLength(size_t newMaxLength);
 	uint8_t applyOffset(uint8_t inputRow, int inputOffset);
+
+	// 8 cell row helpers for the 2D engines.
+	// Edge modes are 0 clip, 1 wrap, 2 klein bottle, 3 random
+	static uint8_t reverseRow(uint8_t row);
+	static void getHorizontalNeighbours(uint8_t row, int edgeMode, uint8_t& west, uint8_t& east);
+
+	// 8x8 bit-matrix helpers, row r is byte r and column c is bit c of the row
+	static inline uint64_t rotateRows(uint64_t matrix, int inputOffset) {
+		// applyOffset on all eight rows at once, bits that leave a byte
+		// are masked back in at its other end
+		int shift = inputOffset % 8;
+		if (shift < 0)
+			shift += 8;
+		if (shift == 0)
+			return matrix;
+
+		uint64_t low = (0xFFULL >> shift) * 0x0101010101010101ULL;
+		return ((matrix >> shift) & low) | ((matrix << (8 - shift)) & ~low);
+	}
+
+	static inline uint64_t mirrorRows(uint64_t matrix) {
+		// Reverse the bits of every byte
+		matrix = ((matrix >> 1) & 0x5555555555555555ULL) | ((matrix & 0x5555555555555555ULL) << 1);
+		matrix = ((matrix >> 2) & 0x3333333333333333ULL) | ((matrix & 0x3333333333333333ULL) << 2);
+		return ((matrix >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((matrix & 0x0F0F0F0F0F0F0F0FULL) << 4);
+	}
+
+	static inline uint64_t transposeMatrix(uint64_t matrix) {
+		// Three delta swaps, 1x1, 2x2 then 4x4 blocks across the diagonal
+		uint64_t t = (matrix ^ (matrix >> 7)) & 0x00AA00AA00AA00AAULL;
+		matrix ^= t ^ (t << 7);
+		t = (matrix ^ (matrix >> 14)) & 0x0000CCCC0000CCCCULL;
+		matrix ^= t ^ (t << 14);
+		t = (matrix ^ (matrix >> 28)) & 0x00000000F0F0F0F0ULL;
+		return matrix ^ t ^ (t << 28);
+	}
+	static uint64_t getProbabilityMask(float probability);
+
+	template <typename T>
+	static inline T mux(T select, T a, T b) {
+		// Bitwise select, a where select is 0, b where select is 1
+		return static_cast<T>(a ^ ((a ^ b) & select));
+	}
+
+	// Life-like neighbour count kernel, shared by the 2D engines
+	template <typename T>
+	static inline void halfadder(T a, T b, T& sum, T& carry) {
+		sum = a ^ b;
+		carry = a & b;
+	}
+
+	template <typename T>
+	static inline void fulladder(T a, T b, T c, T& sum, T& carry) {
+		T t0, t1, t2;
+		halfadder(a, b, t0, t1);
+		halfadder(t0, c, sum, t2);
+		carry = t2 | t1;
+	}
+
+	template <typename T>
+	static inline T getNextRow(T nw, T n, T ne, T w, T c, T e,
+		T sw, T s, T se, uint32_t ruleValue) {
+		// Parallel bitwise addition, one cell per bit
+		// What the helly
+
+		// Sum north row
+		T Nbit0 = 0, Nbit1 = 0;
+		fulladder<T>(nw, n, ne, Nbit0, Nbit1);
+
+		// Sum current row
+		T Cbit0 = 0, Cbit1 = 0;
+		halfadder<T>(w, e, Cbit0, Cbit1);
+
+		// Sum south row
+		T Sbit0 = 0, Sbit1 = 0;
+		fulladder<T>(sw, s, se, Sbit0, Sbit1);
+
+		return getNextRowFromSums<T>(Nbit0, Nbit1, Cbit0, Cbit1, Sbit0, Sbit1, c, ruleValue);
+	}
+
+	template <typename T>
+	static inline T getNextRowFromSums(T Nbit0, T Nbit1, T Cbit0, T Cbit1,
+		T Sbit0, T Sbit1, T c, uint32_t ruleValue) {
+		// Second half of getNextRow, from the three row sums,
+		// so a row's sum can be shared by the rows above and below
+
+		// North row sum  + current row sum = north_current row sum
+		// (Nbit1, Nbit0) + (Cbit1, Cbit0)  = NCbit2, NCbit0, NCbit1
+		T NCbit0 = 0, carry1 = 0;
+		fulladder<T>(Nbit0, Cbit0, 0, NCbit0, carry1);
+		T NCbit1 = 0, NCbit2 = 0;
+		fulladder<T>(Nbit1, Cbit1, carry1, NCbit1, NCbit2);
+
+		// (north_current row sum)   + south row sum	 = full neighbour sum
+		// (NCbit0, NCbit1, NCbit2)  + (0, Sbit1, Sbit0) = NCSbit3, NCSbit2, NCSbit1, NCSbit0
+		T NCSbit0 = 0, carry2 = 0;
+		fulladder<T>(NCbit0, Sbit0, 0, NCSbit0, carry2);
+		T NCSbit1 = 0, carry3 = 0;
+		fulladder<T>(NCbit1, Sbit1, carry2, NCSbit1, carry3);
+		T NCSbit2 = 0, NCSbit3 = 0;
+		fulladder<T>(NCbit2, 0, carry3, NCSbit2, NCSbit3);
+
+		// Apply rule, the neighbour sum selects birth or survival bits
+		// through a mux tree instead of testing each count
+		T birth = applyCounts<T>(NCSbit0, NCSbit1, NCSbit2, NCSbit3, ruleValue);
+		T survival = applyCounts<T>(NCSbit0, NCSbit1, NCSbit2, NCSbit3, ruleValue >> 9);
+		return static_cast<T>((c & survival) | (static_cast<T>(~c) & birth));
+	}
+
+	template <typename T>
+	static inline T applyCounts(T sum0, T sum1, T sum2, T sum3, uint32_t counts) {
+		// Counts 0 - 7 are looked up on sum bits 0 - 2,
+		// sum bit 3 is only set for a count of 8
+		std::array<T, 8> level{};
+		for (int k = 0; k < 8; k++)
+			level[k] = static_cast<T>(((counts >> k) & 1) ? ~T(0) : T(0));
+
+		for (int k = 0; k < 4; k++)
+			level[k] = mux<T>(sum0, level[2 * k], level[(2 * k) + 1]);
+		for (int k = 0; k < 2; k++)
+			level[k] = mux<T>(sum1, level[2 * k], level[(2 * k) + 1]);
+		T lower = mux<T>(sum2, level[0], level[1]);
+
+		T eight = static_cast<T>(((counts >> 8) & 1) ? ~T(0) : T(0));
+		return mux<T>(sum3, lower, eight);
+	}
 };
\ No newline at end of file
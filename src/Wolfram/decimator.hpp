@@ -0,0 +1,98 @@
+// decimator.hpp
+// Part of the Modular Mooch Wolfram module (VCV Rack)
+//
+// GitHub: https://github.com/WesDaMooch/Modular-Mooch-VCV
+//
+// Copyright (c) 2026 Wesley Lawrence Leggo-Morrell
+// License: GPL-3.0-or-later
+
+#pragma once
+#include "../plugin.hpp"
+#include <array>
+#include <cmath>
+
+static constexpr int NUM_OVERSAMPLE_FACTORS = 4;
+static constexpr std::array<int, NUM_OVERSAMPLE_FACTORS> oversampleFactors{ 1, 2, 4, 8 };
+static constexpr int MAX_OVERSAMPLE = 8;
+
+class PolyphaseDecimator {
+	// Decimates a block of oversample factor samples down to one.
+	// The low pass kernel is split into one sub filter per phase,
+	// each phase keeps its own history so every dot product is contiguous,
+	// four taps at a time.
+public:
+	static constexpr int TAPS_PER_PHASE = 16;
+
+	PolyphaseDecimator() {
+		for (int i = 1; i < NUM_OVERSAMPLE_FACTORS; i++)
+			buildKernel(i);
+	}
+
+	void setFactor(int newFactorIndex) {
+		factorIndex = rack::clamp(newFactorIndex, 0, NUM_OVERSAMPLE_FACTORS - 1);
+		reset();
+	}
+
+	void reset() {
+		history = {};
+		writeIndex = 0;
+	}
+
+	float process(const float* in) {
+		int factor = oversampleFactors[factorIndex];
+		if (factor == 1)
+			return in[0];
+
+		// Newest sample goes to phase 0, oldest to phase (factor - 1)
+		for (int phase = 0; phase < factor; phase++) {
+			float sample = in[factor - 1 - phase];
+			history[phase][writeIndex] = sample;
+			history[phase][writeIndex + TAPS_PER_PHASE] = sample;
+		}
+
+		simd::float_4 sum = 0.f;
+		for (int phase = 0; phase < factor; phase++) {
+			const float* window = &history[phase][writeIndex + 1];
+			const float* taps = kernel[factorIndex][phase].data();
+
+			for (int i = 0; i < TAPS_PER_PHASE; i += 4)
+				sum += simd::float_4::load(window + i) * simd::float_4::load(taps + i);
+		}
+
+		writeIndex = (writeIndex + 1) % TAPS_PER_PHASE;
+		return sum[0] + sum[1] + sum[2] + sum[3];
+	}
+
+protected:
+	using Phase = std::array<float, TAPS_PER_PHASE>;
+
+	std::array<std::array<Phase, MAX_OVERSAMPLE>, NUM_OVERSAMPLE_FACTORS> kernel{};
+	std::array<std::array<float, TAPS_PER_PHASE * 2>, MAX_OVERSAMPLE> history{};
+	int factorIndex = 0;
+	int writeIndex = 0;
+
+	void buildKernel(int index) {
+		// Blackman windowed sinc, cutoff just below the decimated Nyquist
+		int factor = oversampleFactors[index];
+		int length = factor * TAPS_PER_PHASE;
+		float cutoff = 0.45f / factor;
+		float center = (length - 1) * 0.5f;
+
+		std::array<float, MAX_OVERSAMPLE * TAPS_PER_PHASE> h{};
+		float sum = 0.f;
+		for (int n = 0; n < length; n++) {
+			float x = n - center;
+			float sinc = (x == 0.f) ? 1.f : std::sin(2.f * M_PI * cutoff * x) / (2.f * M_PI * cutoff * x);
+			float phase = 2.f * M_PI * n / (length - 1);
+			float window = 0.42f - 0.5f * std::cos(phase) + 0.08f * std::cos(2.f * phase);
+			h[n] = sinc * window;
+			sum += h[n];
+		}
+
+		// Unity gain at DC, taps reversed so windows read oldest to newest
+		for (int phase = 0; phase < factor; phase++) {
+			for (int i = 0; i < TAPS_PER_PHASE; i++)
+				kernel[index][phase][i] = h[phase + factor * (TAPS_PER_PHASE - 1 - i)] / sum;
+		}
+	}
+};
@@ -0,0 +1,94 @@
+// engineList.hpp
+// Part of the Modular Mooch Wolfram module (VCV Rack)
+//
+// GitHub: https://github.com/WesDaMooch/Modular-Mooch-VCV
+//
+// Copyright (c) 2026 Wesley Lawrence Leggo-Morrell
+// License: GPL-3.0-or-later
+
+#pragma once
+#include "algoEngine.hpp"
+#include <array>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+template <typename... Engines>
+class EngineList {
+	// Compile-time engine registry. The engines are stored inline in
+	// registry order, which is also their menu, CV and save slot order.
+	// Each engine type provides a static menuName.
+	// Only the shared state is saved through the list, the engine specific
+	// JSON keys (wolfWorld, lifeRuleB, generationsFrames...) are still
+	// written and read by the module, so a new engine's extra settings
+	// need adding to Wolfram::dataToJson() and dataFromJson() by hand
+public:
+	static constexpr int size = sizeof...(Engines);
+
+	template <int I>
+	using Type = std::tuple_element_t<I, std::tuple<Engines...>>;
+
+	template <int I>
+	Type<I>& get() { return std::get<I>(engines); }
+
+	template <typename E>
+	E& get() { return std::get<E>(engines); }
+
+	template <typename F>
+	void visit(int index, F&& f) {
+		// Calls f with the engine at index as its concrete type,
+		// out of range falls back to the last engine
+		visitImpl(index, f);
+	}
+
+	template <typename F>
+	void forEach(F&& f) {
+		// Calls f(engine, index) for every engine
+		forEachImpl(f, std::index_sequence_for<Engines...>{});
+	}
+
+	std::array<AlgoEngine*, size> getPointers() {
+		std::array<AlgoEngine*, size> out{};
+		forEach([&](AlgoEngine& e, int i) { out[i] = &e; });
+		return out;
+	}
+
+	static std::vector<std::string> getMenuNames() {
+		return { Engines::menuName... };
+	}
+
+private:
+	std::tuple<Engines...> engines;
+
+	template <int I, typename F>
+	void visitCase(F& f) {
+		// Cases past the end of the list fall back to the last engine
+		if constexpr (I < size)
+			f(std::get<I>(engines));
+		else
+			f(std::get<size - 1>(engines));
+	}
+
+	template <typename F>
+	void visitImpl(int index, F& f) {
+		// A plain switch so the compiler can build a jump table
+		static_assert(size <= 8, "EngineList::visit handles up to 8 engines");
+		switch (index) {
+			case 0: visitCase<0>(f); break;
+			case 1: visitCase<1>(f); break;
+			case 2: visitCase<2>(f); break;
+			case 3: visitCase<3>(f); break;
+			case 4: visitCase<4>(f); break;
+			case 5: visitCase<5>(f); break;
+			case 6: visitCase<6>(f); break;
+			case 7: visitCase<7>(f); break;
+			default: visitCase<size - 1>(f); break;
+		}
+	}
+
+	template <typename F, size_t... I>
+	void forEachImpl(F& f, std::index_sequence<I...>) {
+		(f(std::get<I>(engines), static_cast<int>(I)), ...);
+	}
+};
@@ -0,0 +1,25 @@
+// expanderMessage.hpp
+// Part of the Modular Mooch Wolfram module (VCV Rack)
+//
+// GitHub: https://github.com/WesDaMooch/Modular-Mooch-VCV
+//
+// Copyright (c) 2026 Wesley Lawrence Leggo-Morrell
+// License: GPL-3.0-or-later
+
+#pragma once
+#include <cstdint>
+
+struct WolframToExpanderMessage {
+	// Sent every sample from Wolfram to an expander on its right
+	uint64_t matrix = 0;	// Display matrix of the active engine
+};
+
+struct ExpanderToWolframMessage {
+	// Sent every sample from the expander back to Wolfram
+	float viewOffset = 0.f;	// -1 - 1
+	bool reverse = false;	// Direction CV high
+	float scrub = 0.f;		// 0 - 1
+	float stampX = 0.f;		// -1 - 1
+	float stampY = 0.f;
+	float transform = 0.f;	// 0 - 1
+};
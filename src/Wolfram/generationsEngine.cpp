@@ -0,0 +1,459 @@
+// generationsEngine.cpp
+// Part of the Modular Mooch Wolfram module (VCV Rack)
+//
+// GitHub: https://github.com/WesDaMooch/Modular-Mooch-VCV
+//
+// Copyright (c) 2026 Wesley Lawrence Leggo-Morrell
+// License: GPL-3.0-or-later
+
+#include "generationsEngine.hpp"
+
+const char GenerationsEngine::modeLabel[GenerationsEngine::NUM_MODES][5] = {
+	"CLIP",	// A plane bounded by 0s
+	"WRAP",	// Donut-shaped torus
+	"BOTL",	// Klein bottle - One pair of opposite edges are reversed
+	"RAND"	// Plane is bounded by randomness
+};
+
+const std::array<GenerationsEngine::Rule, GenerationsEngine::NUM_RULES> GenerationsEngine::rule{ {
+	// Rules from the MCell rule library & LifeWiki
+	{ "WORM", 0x1B024U, 6 },	// Worms				B25/S3467/6
+	{ "WAND", 0x71D8U, 5 },		// Wanderers			B34678/S345/5
+	{ "TRNS", 0x7044U, 5 },		// Transers				B26/S345/5
+	{ "SWRL", 0x1818U, 8 },		// Swirl				B34/S23/8
+	{ "STIK", 0xF004U, 6 },		// Sticks				B2/S3456/6
+	{ "STAR", 0x7004U, 4 },		// Star Wars			B2/S345/4
+	{ "SPRL", 0x81CU, 5 },		// Spirals				B234/S2/5
+	{ "SNAK", 0x1B224U, 6 },	// Snake				B25/S03467/6
+	{ "SEDI", 0x3C3E4U, 4 },	// Sediment				B25678/S05678/4
+	{ "RAIN", 0x80CU, 8 },		// RainZha				B23/S2/8
+	{ "LINE", 0x7F30U, 3 },		// Lines				B458/S012345/3
+	{ "LAVA", 0x7DF0U, 8 },		// Lava					B45678/S12345/8
+	{ "FROG", 0xC18U, 3 },		// Frogs				B34/S12/3
+	{ "FIRE", 0x7018U, 6 },		// Prairie on Fire		B34/S345/6
+	{ "EDGE", 0x7008U, 6 },		// Living on the Edge	B3/S345/6
+	{ "CIRC", 0x781EU, 8 },		// Circuit Genesis		B1234/S2345/8
+	{ "CATR", 0x1ED88U, 4 },	// Caterpillars			B378/S124567/4
+	{ "BRN6", 0x8054U, 3 },		// Brain 6				B246/S6/3
+	{ "BRAN", 0x4U, 3 },		// Brian's Brain		B2/S/3
+	{ "BOWS", 0x1300CU, 8 },	// Flaming Starbows		B23/S347/8
+	{ "BELZ", 0x180CU, 8 },		// Belzhab				B23/S23/8
+	{ "BANR", 0x198B8U, 5 },	// Banners				B3457/S2367/5
+} };
+
+const std::array<GenerationsEngine::Seed, GenerationsEngine::NUM_SEEDS> GenerationsEngine::seed{ {
+	{ "SPOT", 0x1818000000ULL },		// 2x2 block
+	{ "RNDS", 0ULL },					// Sparse / Half Density Random
+	{ "RNDM", 0ULL },					// Symmetrical / Mirrored Random
+	{ " RND", 0ULL },					// True Random
+	{ "RING", 0x3C24243C0000ULL },		// Hollow 4x4 square
+	{ "PAIR", 0x1800000000ULL },		// Domino
+	{ "LINE", 0x3C00000000ULL },		// Row of 4
+	{ "GATE", 0x242400000000ULL },		// Two vertical dominoes
+	{ "DOTS", 0x240000240000ULL },		// Corners of a 4x4 square
+	{ "DIAG", 0x2040810204000ULL },		// Diagonal line
+	{ "CROS", 0x103810000000ULL },		// Plus sign
+	{ "CHEK", 0x281428140000ULL },		// 4x4 checkerboard
+} };
+
+GenerationsEngine::GenerationsEngine() {
+	memcpy(engineLabel, "GENS", 5);
+	seedFrame(frameBuffer[readHead]);
+	updateDisplay(false);
+}
+
+void GenerationsEngine::updateDisplay(bool advance, size_t length) {
+	playheadsDirty = true;
+	if (advance)
+		advanceHeads(length);
+
+	size_t head = getScrubHead();
+	displayMatrix = transformDisplay(getViewFrame(head));
+
+	// Count living and dying cells
+	population = __builtin_popcountll(frameBuffer[head][0]);
+	dyingPopulation = __builtin_popcountll(getDying(frameBuffer[head]));
+	displayMatrixUpdated = true;
+}
+
+void GenerationsEngine::inject(int inject, bool sync) {
+	// Births only land on dead cells, removing kills alive cells outright
+	Frame& frame = frameBuffer[sync ? writeHead : readHead];
+	bool addCell = (inject > 0);
+	int steps = inject < 0 ? -inject : inject;
+
+	for (int step = 0; step < steps; step++) {
+		uint64_t targetMask = addCell ? ~(frame[0] | getDying(frame)) : frame[0];
+
+		// Count target bits
+		int targetCount = __builtin_popcountll(targetMask);
+		if (targetCount == 0)
+			break;
+
+		// Random target index
+		int target = rack::random::get<uint32_t>() % targetCount;
+
+		uint64_t mask = targetMask;
+		while (target--)
+			mask &= (mask - 1);
+
+		uint64_t bitMask = mask & -mask;
+
+		frame[0] = addCell ? (frame[0] | bitMask) : (frame[0] & ~bitMask);
+	}
+}
+
+void GenerationsEngine::updateMenuParams(const EngineMenuParams& p) {
+	// Rule
+	int newRuleSelect = updateSelect(p.menuDelta[EngineMenuParams::RULE_DELTA],
+		p.menuReset[EngineMenuParams::RULE_RESET],
+		ruleSelect, ruleDefault, NUM_RULES);
+	setRuleSelect(newRuleSelect);
+
+	// Seed
+	int newSeedSelect = updateSelect(p.menuDelta[EngineMenuParams::SEED_DELTA],
+		p.menuReset[EngineMenuParams::SEED_RESET],
+		seedIndex, seedDefault, NUM_SEEDS);
+	setSeed(newSeedSelect);
+
+	// Mode
+	int newModeSelect = updateSelect(p.menuDelta[EngineMenuParams::MODE_DELTA],
+		p.menuReset[EngineMenuParams::MODE_RESET],
+		modeIndex, modeDefault, NUM_MODES);
+	setMode(newModeSelect);
+}
+
+void GenerationsEngine::process(const EngineCoreParams& p, EngineOutput& out) {
+
+	bool refreshDisplay = p.step;
+	bool syncStep = p.sync && p.step;
+	setPlayheadLengths(p);
+	if (updateScrub(p))
+		refreshDisplay = true;
+	if (updateTransform(p))
+		refreshDisplay = true;
+	generate = rack::random::get<float>() < p.probability;
+
+	if (!p.sync || (syncStep))
+		setRuleCv(p.ruleCv);
+
+	bool injectOccured = (p.inject != 0);
+	if (injectOccured && p.sync)
+		injectPending += p.inject;
+
+	// Non-sync inject
+	if (injectOccured && !p.sync) {
+		inject(p.inject, p.sync);
+		refreshDisplay = true;
+	}
+
+	// Reset
+	bool seedReset = (p.miniMenuChanged && generate) && !p.sync;
+
+	if (p.miniMenuChanged && p.sync)
+		seedResetPending = true;
+
+	if (p.reset && p.sync)
+		resetPending = true;
+
+	bool resetStep = ((p.reset || seedReset) && !p.sync) || ((resetPending || seedResetPending) && syncStep);
+	if (resetStep) {
+		if (generate) {
+			seedFrame(frameBuffer[p.sync ? writeHead : readHead]);
+			generate = false;
+		}
+		else if (!seedResetPending) {
+			if (p.sync) {
+				writeHead = 0;
+				playheadResetPending = true;
+			}
+			else {
+				readHead = 0;
+				writeHead = 1;
+				resetPlayheads();
+			}
+		}
+		resetPending = false;
+		seedResetPending = false;
+		refreshDisplay = true;
+	}
+
+	// Per cell probability, every step but a reset generates
+	if (p.cellProbability)
+		generate = !resetStep;
+
+	// Generate
+	if (generate && p.step) {
+		stepFrame(frameBuffer[readHead], frameBuffer[writeHead]);
+		if (p.cellProbability) {
+			// All planes of a cell update together
+			uint64_t cellMask = getProbabilityMask(p.probability);
+			for (int i = 0; i < NUM_PLANES; i++)
+				frameBuffer[writeHead][i] = mux<uint64_t>(cellMask, frameBuffer[readHead][i], frameBuffer[writeHead][i]);
+		}
+		refreshDisplay = true;
+	}
+
+	// Sync inject
+	if (injectPending && syncStep) {
+		inject(injectPending, p.sync);
+		injectPending = 0;
+	}
+
+	// Offset
+	int newOffset = p.offset - 4;
+	if ((!p.sync && (offset != newOffset)) || syncStep) {
+		offset = newOffset;
+		refreshDisplay = true;
+	}
+
+	// Update
+	if (refreshDisplay)
+		updateDisplay(p.step, p.length);
+
+	// Output
+	// X - Returns the population (number of alive cells) scaled to 0 - 1
+	out.x = population * densityScaler;
+	out.xIndex = population;
+	out.xLevels = 65;
+
+	// Y - Returns the density of dying cells scaled to 0 - 1
+	out.y = dyingPopulation * densityScaler;
+	out.yIndex = dyingPopulation;
+	out.yLevels = 65;
+
+	// X Pulse - True if population (number of alive cells) has grown
+	if (displayMatrixUpdated && (population > prevPopulation))
+		out.xPulse = true;
+	prevPopulation = population;
+
+	// Y Pulse - True if every state stays the same (no change occurs),
+	// also true if output repeats while looping
+	if (displayMatrixUpdated && (frameBuffer[readHead] == prevFrame))
+		out.yPulse = true;
+	prevFrame = frameBuffer[readHead];
+
+	// Mode LED brightness
+	out.modeLED = static_cast<float>(modeIndex) * modesScaler;
+
+	out.matrix = displayMatrix;
+	displayMatrixUpdated = false;
+
+	if (updatePlayheads(p))
+		renderPlayheads(p);
+	copyPlayheads(p, out);
+}
+
+void GenerationsEngine::renderPlayheads(const EngineCoreParams& p) {
+	// Each extra playhead renders the same outputs as the main head
+	// from its own frame, no extra generation
+	for (int i = 0; i < p.numPlayheads; i++) {
+		const Frame& frame = frameBuffer[getPlayheadFrame(p, i)];
+
+		int framePopulation = __builtin_popcountll(frame[0]);
+		int frameDying = __builtin_popcountll(getDying(frame));
+		playheadOutput[i].x = framePopulation * densityScaler;
+		playheadOutput[i].xIndex = framePopulation;
+		playheadOutput[i].y = frameDying * densityScaler;
+		playheadOutput[i].yIndex = frameDying;
+	}
+}
+
+void GenerationsEngine::reset() {
+	frameBuffer = {};
+	setBufferFrame(0, 0, true);
+	setReadHead(0);
+	setWriteHead(1);
+	setRuleSelect(ruleDefault);
+	setSeed(seedDefault);
+	setMode(modeDefault);
+	seedFrame(frameBuffer[readHead]);
+	updateDisplay(false);
+}
+
+// Save setters
+void GenerationsEngine::setBufferFrame(uint64_t newFrame, int index,
+	bool setDisplayMatrix) {
+	// Sets the alive plane, cells start with no dying states
+	if (setDisplayMatrix) {
+		displayMatrix = newFrame;
+	}
+	else if ((index >= 0) && (index < MAX_SEQUENCE_LENGTH)) {
+		frameBuffer[index] = {};
+		frameBuffer[index][0] = newFrame;
+	}
+}
+
+void GenerationsEngine::onRuleChange() {
+	ruleIndex = rack::clamp(ruleSelect + ruleCv, 0, NUM_RULES - 1);
+}
+
+void GenerationsEngine::setRuleSelect(int newRule) {
+	ruleSelect = rack::clamp(newRule, 0, NUM_RULES - 1);
+	onRuleChange();
+}
+
+void GenerationsEngine::setRuleCv(float newRuleCv) {
+	ruleCv = static_cast<int>(std::round(newRuleCv * NUM_RULES));
+	onRuleChange();
+}
+
+void GenerationsEngine::setSeed(int newSeed) {
+	seedIndex = rack::clamp(newSeed, 0, NUM_SEEDS - 1);
+}
+
+void GenerationsEngine::setMode(int newMode) {
+	modeIndex = rack::clamp(newMode, 0, NUM_MODES - 1);
+}
+
+// Save getters
+uint64_t GenerationsEngine::getBufferFrame(int index,
+	bool getDisplayMatrix,
+	bool getDisplayMatrixSave) {
+
+	if (getDisplayMatrix || getDisplayMatrixSave)
+		return displayMatrix;
+	else if ((index >= 0) && (index < MAX_SEQUENCE_LENGTH))
+		return frameBuffer[index][0];
+	else
+		return 0;
+}
+
+int GenerationsEngine::getRuleSelect() {
+	return ruleSelect;
+}
+
+int GenerationsEngine::getSeed() {
+	return seedIndex;
+}
+
+int GenerationsEngine::getMode() {
+	return modeIndex;
+}
+
+// State planes
+void GenerationsEngine::setFramePlane(uint64_t newPlane, int frame, int plane) {
+	if ((frame >= 0) && (frame < MAX_SEQUENCE_LENGTH) && (plane >= 0) && (plane < NUM_PLANES))
+		frameBuffer[frame][plane] = newPlane;
+}
+
+uint64_t GenerationsEngine::getFramePlane(int frame, int plane) {
+	if ((frame >= 0) && (frame < MAX_SEQUENCE_LENGTH) && (plane >= 0) && (plane < NUM_PLANES))
+		return frameBuffer[frame][plane];
+	return 0;
+}
+
+void GenerationsEngine::seedFrame(Frame& frame) {
+	frame = {};
+
+	if (seedIndex == 1) {
+		// Sparse / half density random
+		frame[0] = rack::random::get<uint64_t>() & rack::random::get<uint64_t>();
+	}
+	else if (seedIndex == 2) {
+		// Symmetrical / mirrored random
+		uint32_t randomHalf = rack::random::get<uint32_t>();
+		uint64_t mirroredRandomHalf = 0;
+		for (int i = 0; i < 4; i++) {
+			uint8_t row = (randomHalf >> (i * 8)) & 0xFFUL;
+			mirroredRandomHalf |= static_cast<uint64_t>(row) << ((3 - i) * 8);
+		}
+		frame[0] = randomHalf | (mirroredRandomHalf << 32);
+	}
+	else if (seedIndex == 3) {
+		// True random
+		frame[0] = rack::random::get<uint64_t>();
+	}
+	else {
+		frame[0] = seed[seedIndex].value;
+	}
+}
+
+void GenerationsEngine::stepFrame(const Frame& read, Frame& write) {
+	// The whole board in one pass, the alive plane is padded and
+	// shifted into its eight neighbour planes as in the Life engine
+
+	// Eight matrix rows + top & bottom padding
+	std::array<uint8_t, 10> row{};
+
+	for (int i = 1; i < 9; i++)
+		row[i] = (read[0] >> ((i - 1) * 8)) & 0xFFULL;
+
+	if (modeIndex == 1) {
+		// Wrap
+		row[0] = row[8];
+		row[9] = row[1];
+	}
+	else if (modeIndex == 2) {
+		// Klein bottle
+		row[0] = reverseRow(row[8]);
+		row[9] = reverseRow(row[1]);
+	}
+	else if (modeIndex == 3) {
+		// Random
+		row[0] = rack::random::get<uint8_t>();
+		row[9] = rack::random::get<uint8_t>();
+	}
+
+	// NW, N, NE, W, C, E, SW, S, SE
+	std::array<uint64_t, 9> plane{};
+	for (int i = 1; i < 9; i++) {
+		uint8_t nw = 0, ne = 0, w = 0, e = 0, sw = 0, se = 0;
+		getHorizontalNeighbours(row[i - 1], modeIndex, nw, ne);
+		getHorizontalNeighbours(row[i], modeIndex, w, e);
+		getHorizontalNeighbours(row[i + 1], modeIndex, sw, se);
+
+		std::array<uint8_t, 9> rowPlane{ nw, row[i - 1], ne, w, row[i], e, sw, row[i + 1], se };
+		for (int j = 0; j < 9; j++)
+			plane[j] |= static_cast<uint64_t>(rowPlane[j]) << ((i - 1) * 8);
+	}
+
+	uint64_t alive = read[0];
+	uint64_t dying = getDying(read);
+	uint64_t next = getNextRow<uint64_t>(plane[0], plane[1], plane[2], plane[3],
+		plane[4], plane[5], plane[6], plane[7], plane[8], rule[ruleIndex].value);
+
+	// Only dead cells can be born,
+	// alive cells that do not survive start dying
+	write[0] = next & ~dying;
+	uint64_t died = alive & ~next;
+
+	// Dying cells age by one, counted in binary across planes 1 - 3
+	uint64_t carry = dying;
+	for (int k = 1; k < NUM_PLANES; k++) {
+		write[k] = read[k] ^ carry;
+		carry &= read[k];
+	}
+	write[1] |= died;
+
+	// Cells reaching the last state are dead
+	int lastAge = rule[ruleIndex].states - 1;
+	uint64_t expired = dying;
+	for (int k = 1; k < NUM_PLANES; k++)
+		expired &= ((lastAge >> (k - 1)) & 1) ? write[k] : ~write[k];
+
+	for (int k = 1; k < NUM_PLANES; k++)
+		write[k] &= ~expired;
+}
+
+uint64_t GenerationsEngine::getViewFrame(size_t index) {
+	// Alive plane as it is displayed, offset applied
+	return rotateRows(frameBuffer[index][0], offset);
+}
+
+// UI getters
+void GenerationsEngine::getRuleActiveLabel(char out[5]) {
+	memcpy(out, rule[ruleIndex].label, 5);
+}
+
+void GenerationsEngine::getRuleSelectLabel(char out[5]) {
+	memcpy(out, rule[ruleSelect].label, 5);
+}
+
+void GenerationsEngine::getSeedLabel(char out[5]) {
+	memcpy(out, seed[seedIndex].label, 5);
+}
+
+void GenerationsEngine::getModeLabel(char out[5]) {
+	memcpy(out, modeLabel[modeIndex], 5);
+}
@@ -0,0 +1,111 @@
+// generationsEngine.hpp
+// Part of the Modular Mooch Wolfram module (VCV Rack)
+//
+// GitHub: https://github.com/WesDaMooch/Modular-Mooch-VCV
+//
+// Copyright (c) 2026 Wesley Lawrence Leggo-Morrell
+// License: GPL-3.0-or-later
+
+#pragma once
+#include "algoEngine.hpp"
+
+class GenerationsEngine final : public AlgoEngine {
+	// Multi-state Life, alive cells that fail to survive pass through
+	// dying states before they are dead, and only dead cells can be born.
+	// A cell's state is spread over bit-planes, plane 0 is alive,
+	// planes 1 - 3 count how long a cell has been dying
+public:
+	GenerationsEngine();
+
+	static constexpr const char* menuName = "Generations";
+
+	void updateDisplay(bool advance, size_t length = 8) override;
+	void updateMenuParams(const EngineMenuParams& p) override;
+
+	void process(const EngineCoreParams& p, EngineOutput& out) override;
+
+	void reset() override;
+
+	// Save setters
+	void setBufferFrame(uint64_t newFrame, int index,
+		bool setDisplayMatrix = false) override;
+
+	void setRuleSelect(int newRule) override;
+	void setRuleCv(float newRuleCv) override;
+	void setSeed(int newSeed) override;
+	void setMode(int newMode) override;
+
+	// Save getters
+	uint64_t getBufferFrame(int index,
+		bool getDisplayMatrix = false,
+		bool getDisplayMatrixSave = false) override;
+
+	int getRuleSelect() override;
+	int getSeed() override;
+	int getMode() override;
+
+	// State planes
+	static constexpr int NUM_PLANES = 4;
+
+	void setFramePlane(uint64_t newPlane, int frame, int plane);
+	uint64_t getFramePlane(int frame, int plane);
+
+	// UI getters
+	void getRuleActiveLabel(char out[5]) override;
+	void getRuleSelectLabel(char out[5]) override;
+	void getSeedLabel(char out[5]) override;
+	void getModeLabel(char out[5]) override;
+
+protected:
+	struct Rule {
+		char label[5];
+		uint32_t value;	// Birth bits 0 - 8, survival bits 9 - 17
+		int states;		// Including alive and dead, 3 - 8
+	};
+
+	struct Seed {
+		char label[5];
+		uint64_t value;
+	};
+
+	using Frame = std::array<uint64_t, NUM_PLANES>;
+	std::array<Frame, MAX_SEQUENCE_LENGTH> frameBuffer{};
+
+	static constexpr int NUM_MODES = 4;
+	static const char modeLabel[NUM_MODES][5];
+	static constexpr int modeDefault = 1;
+	int modeIndex = modeDefault;
+
+	static constexpr int NUM_RULES = 22;
+	static const std::array<Rule, NUM_RULES> rule;
+	static constexpr int ruleDefault = 18;
+	int ruleSelect = ruleDefault;
+	int ruleCv = 0;
+	int ruleIndex = ruleDefault;
+
+	static constexpr int NUM_SEEDS = 12;
+	static const std::array<Seed, NUM_SEEDS> seed;
+	static constexpr int seedDefault = 3;
+	int seedIndex = seedDefault;
+
+	int population = 0;
+	int prevPopulation = 0;
+	int dyingPopulation = 0;
+	Frame prevFrame{};
+
+	static constexpr float densityScaler = 1.f / 64.f;
+	static constexpr float modesScaler = 1.f / (static_cast<float>(NUM_MODES) - 1.f);
+
+	void inject(int inject, bool sync) override;
+	void renderPlayheads(const EngineCoreParams& p);
+	void onRuleChange() override;
+
+	void seedFrame(Frame& frame);
+	void stepFrame(const Frame& read, Frame& write);
+	uint64_t getViewFrame(size_t index);
+
+	// Helpers
+	static inline uint64_t getDying(const Frame& frame) {
+		return frame[1] | frame[2] | frame[3];
+	}
+};
@@ -83,23 +83,42 @@ const std::array<LifeEngine::Seed, LifeEngine::NUM_SEEDS> LifeEngine::seed{ {
 	{ "34C3", 0x3C2464140000ULL },		// 3-4 Life Spaceship 					Rule: 3-4 Life
 } };
 
+const std::array<uint64_t, LifeEngine::NUM_RULE_MASKS> LifeEngine::ruleMasks{ {
+	// Set bits run rule A, clear bits rule B
+	UINT64_MAX,				// Off, rule A everywhere
+	0x0F0F0F0F0F0F0F0FULL,	// Side by side
+	0x00000000FFFFFFFFULL,	// Top & bottom
+	0xAA55AA55AA55AA55ULL,	// Checkerboard
+	0xCCCC3333CCCC3333ULL,	// 2x2 checkerboard
+	0x007E7E7E7E7E7E00ULL,	// Centre & border
+	0						// Engine display, set with the mask
+} };
+
+const std::array<LifeEngine::StampVariants, LifeEngine::NUM_STAMPS> LifeEngine::stampVariants = LifeEngine::buildStampVariants();
+
 LifeEngine::LifeEngine() {
 	memcpy(engineLabel, "LIFE", 5);
+	setMaxLength(matrixBuffer.size());
+	onRuleChange();
 	matrixBuffer[readHead] = rack::random::get<uint64_t>();
 	updateDisplay(false);
 }
 
 void LifeEngine::updateDisplay(bool advance, size_t length) {
+	playheadsDirty = true;
 	if (advance)
 		advanceHeads(length);
 
-	// Apply offset
-	uint64_t tempMatrix = 0;
-	for (int i = 0; i < 8; i++) {
-		uint8_t row = (matrixBuffer[readHead] >> (i * 8)) & 0xFFULL;
-		tempMatrix |= uint64_t(applyOffset(row, offset)) << (i * 8);
-	}
-	displayMatrix = tempMatrix;
+	displayMatrix = getViewFrame(readHead);
+
+	// Large worlds keep the visible window in the sequence buffer,
+	// for saving and inject
+	if (worldSize > 8)
+		matrixBuffer[readHead] = displayMatrix;
+
+	if (scrubOffset > 0)
+		displayMatrix = getViewFrame(getScrubHead());
+	displayMatrix = transformDisplay(displayMatrix);
 
 	// Count living cells
 	population = __builtin_popcountll(displayMatrix);
@@ -108,7 +127,23 @@ void LifeEngine::updateDisplay(bool advance, size_t length) {
 
 void LifeEngine::inject(int inject, bool sync) {
 	size_t head = sync ? writeHead : readHead;
-	uint64_t matrix = matrixBuffer[head];
+	bool largeWorld = worldSize > 8;
+
+	if ((stampIndex >= 0) && !largeWorld) {
+		uint64_t stamp = stampVariants[stampIndex][stampPosition];
+		matrixBuffer[head] = (inject > 0) ? (matrixBuffer[head] | stamp) : (matrixBuffer[head] ^ stamp);
+		return;
+	}
+
+	uint64_t matrix = largeWorld ? getWindow(worldBuffer[head]) : matrixBuffer[head];
+
+	if (stampIndex >= 0) {
+		// Large worlds stamp into the visible window
+		uint64_t stamp = stampVariants[stampIndex][stampPosition];
+		setWindow(worldBuffer[head], (inject > 0) ? (matrix | stamp) : (matrix ^ stamp));
+		return;
+	}
+
 	bool addCell = (inject > 0);
 	int steps = inject < 0 ? -inject : inject;
 
@@ -116,7 +151,7 @@ void LifeEngine::inject(int inject, bool sync) {
 
 		// Check if row is already full or empty
 		if ((addCell && (matrix == UINT64_MAX)) || (!addCell && (matrix == 0)))
-			return;
+			break;
 
 		// Flip row if removing cells
 		uint64_t targetMask = addCell ? ~matrix : matrix;
@@ -124,7 +159,7 @@ void LifeEngine::inject(int inject, bool sync) {
 		// Count target bits
 		int targetCount = __builtin_popcountll(targetMask);
 		if (targetCount == 0)
-			return;
+			break;
 
 		// Random target index
 		int target = rack::random::get<uint32_t>() % targetCount;
@@ -136,15 +171,20 @@ void LifeEngine::inject(int inject, bool sync) {
 		uint64_t bitMask = mask & -mask;
 
 		matrix = addCell ? (matrix | bitMask) : (matrix & ~bitMask);
-		matrixBuffer[head] = matrix;
 	}
+
+	// Large worlds inject into the visible window
+	if (largeWorld)
+		setWindow(worldBuffer[head], matrix);
+	else
+		matrixBuffer[head] = matrix;
 }
 
 void LifeEngine::updateMenuParams(const EngineMenuParams& p) {
 	// Rule
 	int newRuleSelect = updateSelect(p.menuDelta[EngineMenuParams::RULE_DELTA],
 		p.menuReset[EngineMenuParams::RULE_RESET],
-		ruleSelect, ruleDefault, NUM_RULES);
+		ruleSelect, ruleDefault, getNumRules());
 	setRuleSelect(newRuleSelect);
 
 	// Seed
@@ -160,13 +200,19 @@ void LifeEngine::updateMenuParams(const EngineMenuParams& p) {
 	setMode(newModeSelect);
 }
 
-void LifeEngine::process(const EngineCoreParams& p,
-	float* xOut, float* yOut,
-	bool* xPulse, bool* yPulse,
-	float* modeLED) {
+void LifeEngine::process(const EngineCoreParams& p, EngineOutput& out) {
+	// A new history depth from the UI, heads past it wrap
+	if (matrixBuffer.update())
+		setMaxLength((worldSize > 8) ? MAX_SEQUENCE_LENGTH : matrixBuffer.size());
 
 	bool refreshDisplay = p.step;
 	bool syncStep = p.sync && p.step;
+	setPlayheadLengths(p);
+	if (updateScrub(p))
+		refreshDisplay = true;
+	if (updateTransform(p))
+		refreshDisplay = true;
+	stampPosition = ((p.stampY & 7) * 8) + (p.stampX & 7);
 	generate = rack::random::get<float>() < p.probability;
 
 	if (!p.sync || (syncStep))
@@ -191,7 +237,8 @@ void LifeEngine::process(const EngineCoreParams& p,
 	if (p.reset && p.sync)
 		resetPending = true;
 
-	if (((p.reset || seedReset) && !p.sync) || ((resetPending || seedResetPending) && syncStep)) {
+	bool resetStep = ((p.reset || seedReset) && !p.sync) || ((resetPending || seedResetPending) && syncStep);
+	if (resetStep) {
 		if (generate) {
 			int head = p.sync ? writeHead : readHead;
 			uint64_t resetMatrix = 0;
@@ -218,16 +265,21 @@ void LifeEngine::process(const EngineCoreParams& p,
 				resetMatrix = seed[seedIndex].value;
 			}
 
-			matrixBuffer[head] = resetMatrix;
+			if (worldSize > 8)
+				seedWorld(worldBuffer[head], resetMatrix);
+			else
+				matrixBuffer[head] = resetMatrix;
 			generate = false;
 		}
 		else if (!seedResetPending) {
 			if (p.sync) {
 				writeHead = 0;
+				playheadResetPending = true;
 			}
 			else {
 				readHead = 0;
 				writeHead = 1;
+				resetPlayheads();
 			}
 		}
 		resetPending = false;
@@ -235,13 +287,25 @@ void LifeEngine::process(const EngineCoreParams& p,
 		refreshDisplay = true;
 	}
 
+	// Per cell probability, every step but a reset generates
+	if (p.cellProbability)
+		generate = !resetStep;
+
 	// Generate
-	if (generate && p.step) {
+	if (generate && p.step && (worldSize > 8)) {
+		const World& read = worldBuffer[readHead];
+		World& write = worldBuffer[writeHead];
+		stepWorld(read, write);
+		if (p.cellProbability) {
+			for (int i = 0; i < worldSize; i++)
+				write[i] = mux<uint64_t>(getProbabilityMask(p.probability), read[i], write[i]);
+		}
+		refreshDisplay = true;
+	}
+	else if (generate && p.step) {
 		// 2D cellular automata
 		// Based on parallel bitwise implementation by Tomas Rokicki, Paperclip Optimizer,
 		// and Michael Abrash's (Graphics Programmer's Black Book, Chapter 17) padding method
-		// 
-		// Not optimal but efficent enough and readable
 
 		uint64_t readMatrix = matrixBuffer[readHead];
 		uint64_t writeMatrix = 0;
@@ -275,6 +339,10 @@ void LifeEngine::process(const EngineCoreParams& p,
 			row[9] = rack::random::get<uint8_t>();
 		}
 
+		// Gather the nine planes of the whole board, 
+		// the rule then runs once on all 64 cells
+		std::array<uint64_t, 9> plane{};
+
 		for (int i = 1; i < 9; i++) {
 			// Current row  - C,
 			// 8 neighbours - NW, N, NE, W, E, SW, S, SE
@@ -283,73 +351,20 @@ void LifeEngine::process(const EngineCoreParams& p,
 			uint8_t s = row[i + 1];
 			uint8_t nw = 0, ne = 0, w = 0, e = 0, sw = 0, se = 0;
 
-			getHorizontalNeighbours(n, nw, ne);
-			getHorizontalNeighbours(c, w, e);
-			getHorizontalNeighbours(s, sw, se);
-
-			// Parallel bitwise addition
-			// What the helly
-
-			// Sum north row
-			uint8_t Nbit0 = 0, Nbit1 = 0;
-			fulladder(nw, n, ne, Nbit0, Nbit1);
-
-			// Sum current row
-			uint8_t Cbit0 = 0, Cbit1 = 0;
-			halfadder(w, e, Cbit0, Cbit1);
-
-			// Sum south row
-			uint8_t Sbit0 = 0, Sbit1 = 0;
-			fulladder(sw, s, se, Sbit0, Sbit1);
-
-			// North row sum  + current row sum = north_current row sum
-			// (Nbit1, Nbit0) + (Cbit1, Cbit0)  = NCbit2, NCbit0, NCbit1
-			uint8_t NCbit0 = 0, carry1 = 0;
-			fulladder(Nbit0, Cbit0, 0, NCbit0, carry1);
-			uint8_t NCbit1 = 0, NCbit2 = 0;
-			fulladder(Nbit1, Cbit1, carry1, NCbit1, NCbit2);
-
-			// (north_current row sum)   + south row sum	 = full neighbour sum
-			// (NCbit0, NCbit1, NCbit2)  + (0, Sbit1, Sbit0) = NCSbit3, NCSbit2, NCSbit1, NCSbit0
-			uint8_t NCSbit0 = 0, carry2 = 0;
-			fulladder(NCbit0, Sbit0, 0, NCSbit0, carry2);
-			uint8_t NCSbit1 = 0, carry3 = 0;
-			fulladder(NCbit1, Sbit1, carry2, NCSbit1, carry3);
-			uint8_t NCSbit2 = 0, NCSbit3 = 0;
-			fulladder(NCbit2, 0, carry3, NCSbit2, NCSbit3);
-
-			// MSB <- -> LSB
-			std::array<uint8_t, 9> alive{};
-			alive[0] = static_cast<uint8_t>(~NCSbit3 & ~NCSbit2 & ~NCSbit1 & ~NCSbit0);	// 0 0000
-			alive[1] = static_cast<uint8_t>(~NCSbit3 & ~NCSbit2 & ~NCSbit1 & NCSbit0);	// 1 0001
-			alive[2] = static_cast<uint8_t>(~NCSbit3 & ~NCSbit2 & NCSbit1 & ~NCSbit0);	// 2 0010
-			alive[3] = static_cast<uint8_t>(~NCSbit3 & ~NCSbit2 & NCSbit1 & NCSbit0);	// 3 0011
-			alive[4] = static_cast<uint8_t>(~NCSbit3 & NCSbit2 & ~NCSbit1 & ~NCSbit0);	// 4 0100
-			alive[5] = static_cast<uint8_t>(~NCSbit3 & NCSbit2 & ~NCSbit1 & NCSbit0);	// 5 0101
-			alive[6] = static_cast<uint8_t>(~NCSbit3 & NCSbit2 & NCSbit1 & ~NCSbit0);	// 6 0110
-			alive[7] = static_cast<uint8_t>(~NCSbit3 & NCSbit2 & NCSbit1 & NCSbit0);	// 7 0111
-			alive[8] = static_cast<uint8_t>(NCSbit3 & ~NCSbit2 & ~NCSbit1 & ~NCSbit0);	// 8 1000
-
-			// Apply rule
-			uint8_t birth = 0;
-			uint8_t survival = 0;
-
-			for (int k = 0; k < 9; k++) {
-				int birthIndex = k;
-				int survivalIndex = k + 9;
-
-				if (rule[ruleIndex].value & (1 << birthIndex))
-					birth |= alive[k];
-
-				if (rule[ruleIndex].value & (1 << survivalIndex))
-					survival |= alive[k];
-			}
-			uint8_t nextRow = (c & survival) | ((~c) & birth);
+			getHorizontalNeighbours(n, modeIndex, nw, ne);
+			getHorizontalNeighbours(c, modeIndex, w, e);
+			getHorizontalNeighbours(s, modeIndex, sw, se);
 
-			// Update
-			writeMatrix |= static_cast<uint64_t>(nextRow) << ((i - 1) * 8);
+			int shift = (i - 1) * 8;
+			std::array<uint8_t, 9> rowPlane{ nw, n, ne, w, c, e, sw, s, se };
+			for (int j = 0; j < 9; j++)
+				plane[j] |= static_cast<uint64_t>(rowPlane[j]) << shift;
 		}
 
+		writeMatrix = stepRow(plane, ruleMask);
+		if (p.cellProbability)
+			writeMatrix = mux<uint64_t>(getProbabilityMask(p.probability), readMatrix, writeMatrix);
+
 		matrixBuffer[writeHead] = writeMatrix;
 		refreshDisplay = true;
 	}
@@ -360,10 +375,20 @@ void LifeEngine::process(const EngineCoreParams& p,
 		injectPending = 0;
 	}
 
-	// Offset
+	// Offset, large worlds move the visible window instead,
+	// OFFSET moves it across and the expander's view CV up and down
 	int newOffset = p.offset - 4;
-	if ((!p.sync && (offset != newOffset)) || syncStep) {
+	int newViewX = (p.offset * worldSize) / 8;
+	int newViewY = ((worldSize / 2) + static_cast<int>(std::round(p.viewOffset * worldSize)) + worldSize) % worldSize;
+	if (worldSize == 8) {
+		newViewX = 0;
+		newViewY = 0;
+	}
+	bool viewChanged = (offset != newOffset) || (viewX != newViewX) || (viewY != newViewY);
+	if ((!p.sync && viewChanged) || syncStep) {
 		offset = newOffset;
+		viewX = newViewX;
+		viewY = newViewY;
 		refreshDisplay = true;
 	}
 
@@ -373,31 +398,53 @@ void LifeEngine::process(const EngineCoreParams& p,
 
 	// Output
 	// X - Returns the population (number of alive cells) scaled to 0 - 1
-	*xOut = population * xVoltageScaler;
+	out.x = population * xVoltageScaler;
+	out.xIndex = population;
+	out.xLevels = 65;
 	
 	// Y - Returns the 64-bit number display matrix scaled to 0 - 1
-	*yOut = displayMatrix * yVoltageScaler;
+	out.y = displayMatrix * yVoltageScaler;
+	out.yIndex = static_cast<int>(displayMatrix >> 56);	// Top row, when quantised
+	out.yLevels = 256;
 
 	// X Pulse - True if population (number of alive cells) has grown
 	if (displayMatrixUpdated && (population > prevPopulation))
-		*xPulse = true;
+		out.xPulse = true;
 	prevPopulation = population;
 
 	// Y Pulse - True if life becomes stagnant (no change occurs),
 	// also true if output repeats while looping
 	if (displayMatrixUpdated && (displayMatrix == prevOutputMatrix))
-		*yPulse = true;
+		out.yPulse = true;
 	prevOutputMatrix = displayMatrix;
 
 	// Mode LED brightness
-	*modeLED = static_cast<float>(modeIndex) * modesScaler;
+	out.modeLED = static_cast<float>(modeIndex) * modesScaler;
 
+	out.matrix = displayMatrix;
 	displayMatrixUpdated = false;
+
+	if (updatePlayheads(p))
+		renderPlayheads(p);
+	copyPlayheads(p, out);
+}
+
+void LifeEngine::renderPlayheads(const EngineCoreParams& p) {
+	// Each extra playhead renders the same outputs as the main head
+	// from its own frame, no extra generation
+	for (int i = 0; i < p.numPlayheads; i++) {
+		uint64_t matrix = getViewFrame(getPlayheadFrame(p, i));
+
+		int framePopulation = __builtin_popcountll(matrix);
+		playheadOutput[i].x = framePopulation * xVoltageScaler;
+		playheadOutput[i].xIndex = framePopulation;
+		playheadOutput[i].y = matrix * yVoltageScaler;
+		playheadOutput[i].yIndex = static_cast<int>(matrix >> 56);
+	}
 }
 
 void LifeEngine::reset() {
-	for (int i = 0; i < MAX_SEQUENCE_LENGTH; i++)
-		setBufferFrame(0, i);
+	std::fill(matrixBuffer.begin(), matrixBuffer.end(), 0);
 
 	setBufferFrame(0, 0, true);
 	setReadHead(0);
@@ -406,6 +453,11 @@ void LifeEngine::reset() {
 	setSeed(seedDefault);
 	setMode(modeDefault);
 	matrixBuffer[readHead] = rack::random::get<uint64_t>();
+
+	worldBuffer = {};
+	if (worldSize > 8)
+		seedWorld(worldBuffer[readHead], matrixBuffer[readHead]);
+
 	updateDisplay(false);
 }
 
@@ -415,24 +467,193 @@ void LifeEngine::setBufferFrame(uint64_t newFrame, int index,
 
 	if (setDisplayMatrix)
 		displayMatrix = newFrame;
-	else if ((index >= 0) && (index < MAX_SEQUENCE_LENGTH))
+	else if ((index >= 0) && (index < static_cast<int>(matrixBuffer.size())))
 		matrixBuffer[index] = newFrame;
 }
 
+void LifeEngine::setBufferFrames(const uint64_t* frames, size_t count) {
+	count = std::min(count, matrixBuffer.size());
+	for (size_t i = 0; i < count; i++)
+		matrixBuffer[i] = frames[i];
+}
+
 void LifeEngine::onRuleChange() {
-	ruleIndex = rack::clamp(ruleSelect + ruleCv, 0, NUM_RULES - 1);
+	// The rule is only copied when it changes, a new custom rule
+	// handed over by the UI is picked up here
+	collectCustomRule();
+	bool customChanged = customRuleChanged;
+	customRuleChanged = false;
+	int newRuleIndex = rack::clamp(ruleSelect + ruleCv, 0, getNumRules() - 1);
+
+	// Rule B is copied again, its select may be the custom rule
+	if (customChanged) {
+		ruleBIndex = -1;
+		setRuleB(ruleBSelect);
+	}
+
+	if ((newRuleIndex == ruleIndex) && !customChanged)
+		return;
+
+	ruleIndex = newRuleIndex;
+	getRule(ruleIndex, activeRule);
+}
+
+void LifeEngine::setRuleB(int newRuleBSelect) {
+	// Rule B is only copied when it changes
+	ruleBSelect = newRuleBSelect;
+	int newRuleBIndex = rack::clamp(ruleBSelect, 0, getNumRules() - 1);
+	if (newRuleBIndex == ruleBIndex)
+		return;
+
+	ruleBIndex = newRuleBIndex;
+	getRule(ruleBIndex, activeRuleB);
+}
+
+void LifeEngine::setRuleMask(int newRuleMaskIndex, uint64_t engineMatrix) {
+	ruleMaskIndex = rack::clamp(newRuleMaskIndex, 0, NUM_RULE_MASKS - 1);
+	ruleMask = (ruleMaskIndex == RULE_MASK_ENGINE) ? engineMatrix : ruleMasks[ruleMaskIndex];
+}
+
+void LifeEngine::setStamp(int newStampIndex) {
+	stampIndex = rack::clamp(newStampIndex, -1, NUM_STAMPS - 1);
+}
+
+std::array<LifeEngine::StampVariants, LifeEngine::NUM_STAMPS> LifeEngine::buildStampVariants() {
+	// Rows rotate within their byte for X, the board rotates by whole rows for Y
+	std::array<StampVariants, NUM_STAMPS> variants{};
+	for (int index = 0; index < NUM_STAMPS; index++) {
+		uint64_t stamp = getStamp(index);
+		for (int x = 0; x < 8; x++) {
+			uint64_t shifted = 0;
+			for (int i = 0; i < 8; i++) {
+				uint8_t row = (stamp >> (i * 8)) & 0xFFULL;
+				row = static_cast<uint8_t>((row << x) | (row >> ((8 - x) % 8)));
+				shifted |= static_cast<uint64_t>(row) << (i * 8);
+			}
+
+			for (int y = 0; y < 8; y++)
+				variants[index][(y * 8) + x] = (y == 0) ? shifted : ((shifted << (y * 8)) | (shifted >> (64 - (y * 8))));
+		}
+	}
+	return variants;
+}
+
+uint64_t LifeEngine::getStamp(int index) {
+	// A block and a glider in the corner, then the pattern seeds,
+	// the random seeds are skipped
+	if (index == 0)
+		return 0x0303ULL;
+	if (index == 1)
+		return 0x070402ULL;
+
+	int seedIndex = index - 2;
+	if (seedIndex >= 7)
+		seedIndex += 3;
+	return seed[seedIndex].value;
+}
+
+void LifeEngine::getStampLabel(int index, char out[5]) {
+	if (index == 0) {
+		memcpy(out, "BLOK", 5);
+		return;
+	}
+	if (index == 1) {
+		memcpy(out, "GLDR", 5);
+		return;
+	}
+
+	int seedIndex = index - 2;
+	if (seedIndex >= 7)
+		seedIndex += 3;
+	memcpy(out, seed[rack::clamp(seedIndex, 0, NUM_SEEDS - 1)].label, 5);
+}
+
+int LifeEngine::getNumBankRules() {
+	return NUM_RULES + static_cast<int>(userLifeRules.size());
+}
+
+void LifeEngine::getBankRuleLabel(int index, char out[5]) {
+	int userIndex = index - NUM_RULES;
+
+	if ((index >= 0) && (index < NUM_RULES))
+		memcpy(out, rule[index].label, 5);
+	else if ((userIndex >= 0) && (userIndex < static_cast<int>(userLifeRules.size())))
+		memcpy(out, userLifeRules[userIndex].label, 5);
+	else
+		memcpy(out, "CUST", 5);
+}
+
+int LifeEngine::findSavedRule(int savedIndex, const std::string& label) {
+	if (savedIndex < NUM_RULES)
+		return savedIndex;
+
+	for (int i = 0; i < static_cast<int>(userLifeRules.size()); i++) {
+		if (label == userLifeRules[i].label)
+			return NUM_RULES + i;
+	}
+
+	// The custom rule follows the bank, a bank rule that has gone is reset
+	return (label == "CUST") ? getNumBankRules() : ruleDefault;
+}
+
+int LifeEngine::getNumRules() {
+	return NUM_RULES + static_cast<int>(userLifeRules.size()) + (hasCustomRule ? 1 : 0);
+}
+
+void LifeEngine::getRule(int index, LifeRule& out) {
+	int userIndex = index - NUM_RULES;
+
+	if (index < NUM_RULES) {
+		// Built-in rules are all totalistic, no table needed
+		out = LifeRule();
+		memcpy(out.label, rule[index].label, 5);
+		out.value = rule[index].value;
+	}
+	else if (userIndex < static_cast<int>(userLifeRules.size())) {
+		out = userLifeRules[userIndex];
+	}
+	else if (hasCustomRule) {
+		out = customRule;
+	}
 }
 
 void LifeEngine::setRuleSelect(int newRule) {
-	ruleSelect = rack::clamp(newRule, 0, NUM_RULES - 1);
+	collectCustomRule();
+	ruleSelect = rack::clamp(newRule, 0, getNumRules() - 1);
 	onRuleChange();
 }
 
 void LifeEngine::setRuleCv(float newRuleCv) {
+	// Scaled over the built-in rules, so a voltage picks
+	// the same rule whatever the bank holds
 	ruleCv = static_cast<int>(std::round(newRuleCv * NUM_RULES));
 	onRuleChange();
 }
 
+bool LifeEngine::setCustomRule(const LifeRule* newRule) {
+	// The slot still holds a rule the audio thread has not copied
+	if (customRuleState.load(std::memory_order_acquire) != CUSTOM_IDLE)
+		return false;
+
+	if (newRule)
+		customRuleSlot = *newRule;
+	customRuleState.store(newRule ? CUSTOM_SET : CUSTOM_CLEAR, std::memory_order_release);
+	return true;
+}
+
+void LifeEngine::collectCustomRule() {
+	// Audio thread, takes a rule from the slot and frees it for the next
+	int state = customRuleState.load(std::memory_order_acquire);
+	if (state == CUSTOM_IDLE)
+		return;
+
+	hasCustomRule = (state == CUSTOM_SET);
+	if (hasCustomRule)
+		customRule = customRuleSlot;
+	customRuleState.store(CUSTOM_IDLE, std::memory_order_release);
+	customRuleChanged = true;
+}
+
 void LifeEngine::setSeed(int newSeed) {
 	seedIndex = rack::clamp(newSeed, 0, NUM_SEEDS - 1);
 }
@@ -450,12 +671,19 @@ uint64_t LifeEngine::getBufferFrame(int index,
 		return displayMatrix;
 	else if (getDisplayMatrixSave)
 		return displayMatrix;
-	else if ((index >= 0) && (index < MAX_SEQUENCE_LENGTH))
+	else if ((index >= 0) && (index < static_cast<int>(matrixBuffer.size())))
 		return matrixBuffer[index];
 	else
 		return 0;
 }
 
+void LifeEngine::getBufferFrames(uint64_t* frames, size_t count) {
+	size_t stored = std::min(count, matrixBuffer.size());
+	for (size_t i = 0; i < stored; i++)
+		frames[i] = matrixBuffer[i];
+	std::fill(frames + stored, frames + count, 0);
+}
+
 int LifeEngine::getRuleSelect() { 
 	return ruleSelect; 
 }
@@ -468,13 +696,251 @@ int LifeEngine::getMode() {
 	return modeIndex; 
 }
 
+// Large world
+void LifeEngine::setWorldSize(int newWorldSizeIndex) {
+	newWorldSizeIndex = rack::clamp(newWorldSizeIndex, 0, NUM_WORLD_SIZES - 1);
+	if (newWorldSizeIndex == worldSizeIndex)
+		return;
+
+	// Leaving a large world keeps what was visible in the sequence buffer
+	if (worldSize > 8) {
+		for (int i = 0; i < MAX_SEQUENCE_LENGTH; i++)
+			matrixBuffer[i] = getWindow(worldBuffer[i]);
+	}
+
+	worldSizeIndex = newWorldSizeIndex;
+	worldSize = worldSizes[worldSizeIndex];
+	worldMask = (worldSize == 64) ? UINT64_MAX : ((1ULL << worldSize) - 1);
+	setMaxLength((worldSize > 8) ? MAX_SEQUENCE_LENGTH : matrixBuffer.size());
+	// Window starts centred, as with OFFSET and the view CV at default
+	viewX = (worldSize > 8) ? (worldSize / 2) : 0;
+	viewY = viewX;
+
+	// Entering a large world starts with the 8x8 frames in its corner
+	worldBuffer = {};
+	if (worldSize > 8) {
+		for (int i = 0; i < MAX_SEQUENCE_LENGTH; i++)
+			setWindow(worldBuffer[i], matrixBuffer[i]);
+	}
+
+	updateDisplay(false);
+}
+
+int LifeEngine::getWorldSize() {
+	return worldSizeIndex;
+}
+
+void LifeEngine::setWorldRow(uint64_t newRow, int frame, int row) {
+	if ((frame >= 0) && (frame < MAX_SEQUENCE_LENGTH) && (row >= 0) && (row < worldSize))
+		worldBuffer[frame][row] = newRow & worldMask;
+}
+
+uint64_t LifeEngine::getWorldRow(int frame, int row) {
+	if ((frame >= 0) && (frame < MAX_SEQUENCE_LENGTH) && (row >= 0) && (row < worldSize))
+		return worldBuffer[frame][row];
+	return 0;
+}
+
+void LifeEngine::setHistoryDepth(size_t depth) {
+	matrixBuffer.resize(static_cast<size_t>(rack::clamp(static_cast<int>(depth), MAX_SEQUENCE_LENGTH, MAX_LONG_SEQUENCE_LENGTH)));
+	setMaxLength((worldSize > 8) ? MAX_SEQUENCE_LENGTH : matrixBuffer.size());
+}
+
+void LifeEngine::requestHistoryDepth(size_t depth) {
+	matrixBuffer.request(static_cast<size_t>(rack::clamp(static_cast<int>(depth), MAX_SEQUENCE_LENGTH, MAX_LONG_SEQUENCE_LENGTH)));
+}
+
+void LifeEngine::collectHistory() {
+	matrixBuffer.collect();
+}
+
+uint64_t LifeEngine::getViewFrame(size_t index) {
+	// Frame as it is displayed, offset applied or the large world window
+	if (worldSize > 8)
+		return getWindow(worldBuffer[index]);
+
+	return rotateRows(matrixBuffer[index], offset);
+}
+
+uint64_t LifeEngine::getWindow(const World& world) {
+	uint64_t window = 0;
+	for (int i = 0; i < 8; i++) {
+		uint64_t row = rotateWorldRow(world[(viewY + i) % worldSize], viewX);
+		window |= (row & 0xFFULL) << (i * 8);
+	}
+	return window;
+}
+
+void LifeEngine::setWindow(World& world, uint64_t window) {
+	int shift = (worldSize - viewX) % worldSize;
+	uint64_t windowMask = rotateWorldRow(0xFFULL, shift);
+
+	for (int i = 0; i < 8; i++) {
+		uint64_t row = rotateWorldRow((window >> (i * 8)) & 0xFFULL, shift);
+		uint64_t& worldRow = world[(viewY + i) % worldSize];
+		worldRow = (worldRow & ~windowMask) | row;
+	}
+}
+
+void LifeEngine::seedWorld(World& world, uint64_t resetMatrix) {
+	// Random seeds fill the whole world,
+	// patterns are placed in the visible window of an empty world
+	world = {};
+
+	if (seedIndex == 7) {
+		// Sparse / half density random
+		for (int i = 0; i < worldSize; i++)
+			world[i] = rack::random::get<uint64_t>() & rack::random::get<uint64_t>() & worldMask;
+	}
+	else if (seedIndex == 8) {
+		// Symmetrical / mirrored random
+		for (int i = 0; i < worldSize / 2; i++) {
+			world[i] = rack::random::get<uint64_t>() & worldMask;
+			world[worldSize - 1 - i] = world[i];
+		}
+	}
+	else if (seedIndex == 9) {
+		// True random
+		for (int i = 0; i < worldSize; i++)
+			world[i] = rack::random::get<uint64_t>() & worldMask;
+	}
+	else {
+		setWindow(world, resetMatrix);
+	}
+}
+
+void LifeEngine::stepWorld(const World& read, World& write) {
+	// Same bitwise kernel as the 8x8 board, 64 cells per operation.
+	// Rows with no living neighbours are skipped, unless a rule has B0
+	bool birthOnEmpty = activeRule.isotropic ? activeRule.getTransition(0) : (activeRule.value & 1);
+	if (ruleMaskIndex != RULE_MASK_OFF)
+		birthOnEmpty |= activeRuleB.isotropic ? activeRuleB.getTransition(0) : (activeRuleB.value & 1);
+	int last = worldSize - 1;
+
+	// Top & bottom padding rows
+	uint64_t top = 0;
+	uint64_t bottom = 0;
+	if (modeIndex == 1) {
+		// Wrap
+		top = read[last];
+		bottom = read[0];
+	}
+	else if (modeIndex == 2) {
+		// Klein bottle
+		top = reverseWorldRow(read[last]);
+		bottom = reverseWorldRow(read[0]);
+	}
+	else if (modeIndex == 3) {
+		// Random
+		top = rack::random::get<uint64_t>() & worldMask;
+		bottom = rack::random::get<uint64_t>() & worldMask;
+	}
+
+	// Padded rows, each row's neighbours are found once
+	// and shared by the rows above and below it
+	std::array<uint64_t, MAX_WORLD_SIZE + 2> row;
+	std::array<uint64_t, MAX_WORLD_SIZE + 2> west;
+	std::array<uint64_t, MAX_WORLD_SIZE + 2> east;
+	row[0] = top;
+	std::copy_n(read.begin(), worldSize, row.begin() + 1);
+	row[worldSize + 1] = bottom;
+
+	// Edge cells wrap in the wrap & klein bottle modes, 
+	// random mode fills them per row
+	int lastBit = worldSize - 1;
+	bool wrap = (modeIndex == 1) || (modeIndex == 2);
+	for (int i = 0; i < worldSize + 2; i++) {
+		uint64_t westEdge = 0;
+		uint64_t eastEdge = 0;
+		if (wrap) {
+			westEdge = (row[i] & 1) << lastBit;
+			eastEdge = (row[i] >> lastBit) & 1;
+		}
+		else if (modeIndex == 3) {
+			westEdge = static_cast<uint64_t>(rack::random::get<bool>()) << lastBit;
+			eastEdge = rack::random::get<bool>();
+		}
+		west[i] = (row[i] >> 1) | westEdge;
+		east[i] = ((row[i] << 1) & worldMask) | eastEdge;
+	}
+
+	// The 8x8 rule mask repeats across and down the world
+	std::array<uint64_t, 8> rowMask;
+	for (int i = 0; i < 8; i++)
+		rowMask[i] = ((ruleMask >> (i * 8)) & 0xFFULL) * 0x0101010101010101ULL;
+
+	// Outer totalistic rules share each row's three cell sum with the rows
+	// above and below it, and the row loop has no branches so it vectorises
+	bool masked = (ruleMaskIndex != RULE_MASK_OFF);
+	if (!activeRule.isotropic && !(masked && activeRuleB.isotropic)) {
+		uint32_t ruleA = activeRule.value;
+		uint32_t ruleB = activeRuleB.value;
+		std::array<uint64_t, MAX_WORLD_SIZE + 2> sum0;
+		std::array<uint64_t, MAX_WORLD_SIZE + 2> sum1;
+		for (int i = 0; i < worldSize + 2; i++)
+			fulladder<uint64_t>(west[i], row[i], east[i], sum0[i], sum1[i]);
+
+		// One loop each with and without the mask, no branch per row
+		auto stepRows = [&](auto maskedRows) {
+			for (int i = 0; i < worldSize; i++) {
+				uint64_t c = row[i + 1];
+				uint64_t cSum0 = 0, cSum1 = 0;
+				halfadder<uint64_t>(west[i + 1], east[i + 1], cSum0, cSum1);
+
+				uint64_t next = getNextRowFromSums<uint64_t>(sum0[i], sum1[i], cSum0, cSum1, sum0[i + 2], sum1[i + 2], c, ruleA);
+				if constexpr (decltype(maskedRows)::value) {
+					uint64_t nextB = getNextRowFromSums<uint64_t>(sum0[i], sum1[i], cSum0, cSum1, sum0[i + 2], sum1[i + 2], c, ruleB);
+					next = mux<uint64_t>(rowMask[i & 7], nextB, next);
+				}
+				write[i] = next & worldMask;
+			}
+		};
+		if (masked)
+			stepRows(std::true_type{});
+		else
+			stepRows(std::false_type{});
+		return;
+	}
+
+	for (int i = 0; i < worldSize; i++) {
+		uint64_t n = row[i];
+		uint64_t c = row[i + 1];
+		uint64_t s = row[i + 2];
+
+		if (!(n | c | s) && !birthOnEmpty) {
+			write[i] = 0;
+			continue;
+		}
+
+		write[i] = stepRow({ west[i], n, east[i], west[i + 1], c, east[i + 1], 
+			west[i + 2], s, east[i + 2] }, rowMask[i & 7]) & worldMask;
+	}
+}
+
+uint64_t LifeEngine::stepRow(const std::array<uint64_t, 9>& plane, uint64_t mask) {
+	// Both rules run on every cell and are blended by the mask, no branches per cell
+	uint64_t nextA = applyLifeRule(plane, activeRule);
+	if (ruleMaskIndex == RULE_MASK_OFF)
+		return nextA;
+
+	uint64_t nextB = applyLifeRule(plane, activeRuleB);
+	return (nextA & mask) | (nextB & ~mask);
+}
+
 // UI getters
 void LifeEngine::getRuleActiveLabel(char out[5]) {
-	memcpy(out, rule[ruleIndex].label, 5);
+	memcpy(out, activeRule.label, 5);
 }
 
 void LifeEngine::getRuleSelectLabel(char out[5]) {
-	memcpy(out, rule[ruleSelect].label, 5);
+	int userIndex = ruleSelect - NUM_RULES;
+
+	if (ruleSelect < NUM_RULES)
+		memcpy(out, rule[ruleSelect].label, 5);
+	else if (userIndex < static_cast<int>(userLifeRules.size()))
+		memcpy(out, userLifeRules[userIndex].label, 5);
+	else
+		memcpy(out, hasCustomRule ? customRule.label : "CUST", 5);
 }
 
 void LifeEngine::getSeedLabel(char out[5]) {
@@ -486,27 +952,19 @@ void LifeEngine::getModeLabel(char out[5]) {
 }
 
 // Helpers
-uint8_t LifeEngine::reverseRow(uint8_t row) {
-	row = ((row & 0xF0) >> 4) | ((row & 0x0F) << 4);
-	row = ((row & 0xCC) >> 2) | ((row & 0x33) << 2);
-	row = ((row & 0xAA) >> 1) | ((row & 0x55) << 1);
-	return row;
+uint64_t LifeEngine::reverseWorldRow(uint64_t row) {
+	row = ((row & 0xFFFFFFFF00000000ULL) >> 32) | ((row & 0x00000000FFFFFFFFULL) << 32);
+	row = ((row & 0xFFFF0000FFFF0000ULL) >> 16) | ((row & 0x0000FFFF0000FFFFULL) << 16);
+	row = ((row & 0xFF00FF00FF00FF00ULL) >> 8) | ((row & 0x00FF00FF00FF00FFULL) << 8);
+	row = ((row & 0xF0F0F0F0F0F0F0F0ULL) >> 4) | ((row & 0x0F0F0F0F0F0F0F0FULL) << 4);
+	row = ((row & 0xCCCCCCCCCCCCCCCCULL) >> 2) | ((row & 0x3333333333333333ULL) << 2);
+	row = ((row & 0xAAAAAAAAAAAAAAAAULL) >> 1) | ((row & 0x5555555555555555ULL) << 1);
+	return row >> (64 - worldSize);
 }
 
-void LifeEngine::getHorizontalNeighbours(uint8_t row, uint8_t& west, uint8_t& east) {
-	if (modeIndex == 0) {
-		// Clip
-		west = row >> 1;
-		east = row << 1;
-	}
-	else if (modeIndex == 1 || modeIndex == 2) {
-		// Wrap & klein bottle
-		west = (row >> 1) | (row << 7);
-		east = (row << 1) | (row >> 7);
-	}
-	else if (modeIndex == 3) {
-		// Random
-		west = (row >> 1) | (rack::random::get<bool>() << 7);
-		east = (row << 1) | rack::random::get<bool>();
-	}
+uint64_t LifeEngine::rotateWorldRow(uint64_t row, int shift) {
+	// Rotate right within the world width
+	if (shift == 0)
+		return row;
+	return ((row >> shift) | (row << (worldSize - shift))) & worldMask;
 }
\ No newline at end of file
@@ -8,24 +8,28 @@
 
 #pragma once
 #include "algoEngine.hpp"
+#include "lifeRule.hpp"
+#include <atomic>
+#include <string>
+#include <vector>
 
-class LifeEngine : public AlgoEngine {
+class LifeEngine final : public AlgoEngine {
 public:
 	LifeEngine();
 
+	static constexpr const char* menuName = "Life";
+
 	void updateDisplay(bool advance, size_t length = 8) override;
 	void updateMenuParams(const EngineMenuParams& p) override;
 
-	void process(const EngineCoreParams& p,
-		float* xOut, float* yOut,
-		bool* xPulse, bool* yPulse,
-		float* modeLED) override;
+	void process(const EngineCoreParams& p, EngineOutput& out) override;
 
 	void reset() override;
 
 	// Save setters
 	void setBufferFrame(uint64_t newFrame, int index, 
 		bool setDisplayMatrix = false) override;
+	void setBufferFrames(const uint64_t* frames, size_t count) override;
 
 	void setRuleSelect(int newRule) override;
 	void setRuleCv(float newRuleCv) override;
@@ -36,11 +40,61 @@ public:
 	uint64_t getBufferFrame(int index, 
 		bool getDisplayMatrix = false,
 		bool getDisplayMatrixSave = false) override;
+	void getBufferFrames(uint64_t* frames, size_t count) override;
 
 	int getRuleSelect() override;
 	int getSeed() override;
 	int getMode() override;
 
+	// Large world, an up to 64x64 torus seen through the 8x8 display
+	static constexpr int NUM_WORLD_SIZES = 4;
+	static constexpr int MAX_WORLD_SIZE = 64;
+	static constexpr std::array<int, NUM_WORLD_SIZES> worldSizes{ 8, 16, 32, 64 };
+
+	void setWorldSize(int newWorldSizeIndex);
+	int getWorldSize();
+	void setWorldRow(uint64_t newRow, int frame, int row);
+	uint64_t getWorldRow(int frame, int row);
+
+	// History depth, frames kept by the 8 cell board's sequence buffer.
+	// setHistoryDepth() resizes at once, outside the audio thread,
+	// requestHistoryDepth() and collectHistory() are for the UI thread
+	void setHistoryDepth(size_t depth);
+	void requestHistoryDepth(size_t depth);
+	void collectHistory();
+
+	// Custom rule, compiled on the UI thread and handed to the audio thread
+	// through a single slot, nullptr removes it. Returns false while the
+	// audio thread has not taken the last rule yet, the caller tries again
+	bool setCustomRule(const LifeRule* newRule);
+
+	// Second rule, run on the cells outside the rule mask.
+	// Masks are presets or the display of another engine,
+	// large worlds repeat the mask every 8 cells
+	static constexpr int NUM_RULE_MASKS = 7;
+	static constexpr int RULE_MASK_OFF = 0;
+	static constexpr int RULE_MASK_ENGINE = NUM_RULE_MASKS - 1;
+	static constexpr int ruleBDefault = 4;	// Seeds
+
+	void setRuleB(int newRuleBSelect);
+	void setRuleMask(int newRuleMaskIndex, uint64_t engineMatrix = 0);
+
+	// Stamp inject, a pattern dropped whole at the stamp position.
+	// Positive inject ORs it in, negative inject XORs it,
+	// a stamp of -1 injects random cells
+	static constexpr int NUM_STAMPS = 29;
+	void setStamp(int newStampIndex);
+	static void getStampLabel(int index, char out[5]);
+
+	// Built-in and user bank rules, the custom rule follows them
+	static int getNumBankRules();
+	static void getBankRuleLabel(int index, char out[5]);
+
+	// Rules past the built-in ones are saved with their label,
+	// the user bank can change between sessions.
+	// Returns the index the label has in the bank now
+	static int findSavedRule(int savedIndex, const std::string& label);
+
 	// UI getters
 	void getRuleActiveLabel(char out[5]) override;
 	void getRuleSelectLabel(char out[5]) override;
@@ -58,7 +112,17 @@ protected:
 		uint64_t value;
 	};
 
-	std::array<uint64_t, MAX_SEQUENCE_LENGTH> matrixBuffer{};
+	// Up to MAX_LONG_SEQUENCE_LENGTH on the 8x8 board, large worlds loop 64 frames
+	HistoryBuffer<uint64_t> matrixBuffer{ MAX_SEQUENCE_LENGTH };
+
+	// One row per uint64_t, cells 0 to worldSize - 1
+	using World = std::array<uint64_t, MAX_WORLD_SIZE>;
+	std::array<World, MAX_SEQUENCE_LENGTH> worldBuffer{};
+	int worldSizeIndex = 0;
+	int worldSize = 8;
+	uint64_t worldMask = 0xFFULL;
+	int viewX = 0;
+	int viewY = 0;
 
 	static constexpr int NUM_MODES = 4;
 	static const char modeLabel[NUM_MODES][5];
@@ -70,13 +134,45 @@ protected:
 	static constexpr  int ruleDefault = 11;
 	int ruleSelect = ruleDefault;
 	int ruleCv = 0;
-	int ruleIndex = 0;
+	int ruleIndex = -1;
+
+	// Rules after the built-in ones come from the user rule bank,
+	// then the custom rule if one is set
+	LifeRule activeRule;
+
+	// Custom rule handoff, the UI thread only writes the slot while it is idle,
+	// the audio thread copies it out then sets it idle again
+	enum CustomRuleState {
+		CUSTOM_IDLE,
+		CUSTOM_SET,
+		CUSTOM_CLEAR
+	};
+	LifeRule customRuleSlot;
+	std::atomic<int> customRuleState{ CUSTOM_IDLE };
+	LifeRule customRule;	// Audio thread copy
+	bool hasCustomRule = false;
+	bool customRuleChanged = false;
+
+	static const std::array<uint64_t, NUM_RULE_MASKS> ruleMasks;
+	LifeRule activeRuleB;
+	int ruleBSelect = ruleBDefault;
+	int ruleBIndex = -1;
+	int ruleMaskIndex = RULE_MASK_OFF;
+	uint64_t ruleMask = UINT64_MAX;
 
 	static constexpr int NUM_SEEDS = 30;
 	static const std::array<Seed, NUM_SEEDS> seed;
 	static constexpr int seedDefault = 9;
 	int seedIndex = seedDefault;
 
+	// Every wrapped position of every stamp, built once at plugin load
+	// so choosing a stamp on the audio thread is only an index
+	using StampVariants = std::array<uint64_t, 64>;
+	static const std::array<StampVariants, NUM_STAMPS> stampVariants;
+	static std::array<StampVariants, NUM_STAMPS> buildStampVariants();
+	int stampIndex = -1;
+	int stampPosition = 0;
+
 	int population = 0;
 	int prevPopulation = 0;
 	uint64_t prevOutputMatrix = 0;
@@ -87,24 +183,44 @@ protected:
 	static constexpr float modesScaler = 1.f / (static_cast<float>(NUM_MODES) - 1.f);
 
 	void inject(int inject, bool sync) override;
+	void renderPlayheads(const EngineCoreParams& p);
 	void onRuleChange() override;
+	int getNumRules();
+	void getRule(int index, LifeRule& out);
+	void collectCustomRule();
+
+	// Large world
+	uint64_t getViewFrame(size_t index);
+	uint64_t getWindow(const World& world);
+	void setWindow(World& world, uint64_t window);
+	void seedWorld(World& world, uint64_t resetMatrix);
+	void stepWorld(const World& read, World& write);
+	uint64_t stepRow(const std::array<uint64_t, 9>& plane, uint64_t mask);
+	static uint64_t getStamp(int index);
 
 	// Helpers
-	static inline void halfadder(uint8_t a, uint8_t b,
-		uint8_t& sum, uint8_t& carry) {
-		sum = a ^ b;
-		carry = a & b;
+	template <typename T>
+	static inline T applyNetwork(const std::array<T, 9>& plane, const LifeRule& rule) {
+		// Isotropic non-totalistic rules, one mux per network node,
+		// the same operations whatever the cells so no branches.
+		// Planes are NW, N, NE, W, C, E, SW, S, SE
+		std::array<T, LifeRule::MAX_NODES + 2> value;
+		value[0] = 0;
+		value[1] = static_cast<T>(~T(0));
+		for (int i = 0; i < rule.numNodes; i++) {
+			const LifeRule::Node& node = rule.network[i];
+			value[i + 2] = mux<T>(plane[node.plane], value[node.low], value[node.high]);
+		}
+		return value[rule.root];
 	}
 
-	static inline void fulladder(uint8_t a, uint8_t b, uint8_t c,
-		uint8_t& sum, uint8_t& carry) {
-
-		uint8_t t0, t1, t2;
-		halfadder(a, b, t0, t1);
-		halfadder(t0, c, sum, t2);
-		carry = t2 | t1;
+	static inline uint64_t applyLifeRule(const std::array<uint64_t, 9>& plane, const LifeRule& rule) {
+		if (rule.isotropic)
+			return applyNetwork<uint64_t>(plane, rule);
+		return getNextRow<uint64_t>(plane[0], plane[1], plane[2], plane[3], plane[4],
+			plane[5], plane[6], plane[7], plane[8], rule.value);
 	}
 
-	static uint8_t reverseRow(uint8_t row);
-	void getHorizontalNeighbours(uint8_t row, uint8_t& west, uint8_t& east);
+	uint64_t reverseWorldRow(uint64_t row);
+	uint64_t rotateWorldRow(uint64_t row, int shift);
 };
\ No newline at end of file
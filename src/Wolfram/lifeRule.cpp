@@ -0,0 +1,283 @@
+// lifeRule.cpp
+// Part of the Modular Mooch Wolfram module (VCV Rack)
+//
+// GitHub: https://github.com/WesDaMooch/Modular-Mooch-VCV
+//
+// Copyright (c) 2026 Wesley Lawrence Leggo-Morrell
+// License: GPL-3.0-or-later
+
+#include "lifeRule.hpp"
+#include <cctype>
+#include <cstring>
+#include <fstream>
+
+std::vector<LifeRule> userLifeRules;
+
+// Hensel notation letters for 1 - 4 neighbours, 5 - 7 reuse the letters of 3 - 1.
+// Each letter has one representative neighbourhood (centre clear),
+// every rotation and reflection of it shares the letter
+static const char* henselLetters[5] = {
+	"",
+	"ce",
+	"ceaikn",
+	"ceaikjqrny",
+	"ceaikjqrnytwz"
+};
+
+static const std::array<std::vector<int>, 5> henselNeighbourhoods{ {
+	{},
+	{ 1, 2 },
+	{ 5, 10, 3, 40, 33, 68 },
+	{ 69, 42, 11, 7, 98, 13, 14, 70, 41, 97 },
+	{ 325, 170, 15, 45, 99, 71, 106, 102, 43, 101, 105, 78, 108 }
+} };
+
+static constexpr int CENTRE_BIT = 1 << 4;
+static constexpr int OUTER_BITS = 0x1FF & ~CENTRE_BIT;
+
+struct NeighbourhoodClass {
+	int count = 0;
+	int letter = 0;		// Index into henselLetters, 0 when the count has no letters
+};
+
+static int transformNeighbourhood(int index, int symmetry) {
+	// One of the 8 rotations and reflections of a 3x3 neighbourhood
+	int out = 0;
+	for (int bit = 0; bit < 9; bit++) {
+		if (!((index >> bit) & 1))
+			continue;
+
+		int row = bit / 3;
+		int column = bit % 3;
+		for (int i = 0; i < (symmetry & 3); i++) {
+			int rotated = column;
+			column = 2 - row;
+			row = rotated;
+		}
+		if (symmetry & 4)
+			column = 2 - column;
+
+		out |= 1 << ((row * 3) + column);
+	}
+	return out;
+}
+
+static std::array<NeighbourhoodClass, 512> buildClassTable() {
+	std::array<NeighbourhoodClass, 512> classes{};
+
+	for (int count = 1; count <= 4; count++) {
+		const std::vector<int>& representatives = henselNeighbourhoods[count];
+		for (size_t letter = 0; letter < representatives.size(); letter++) {
+			for (int symmetry = 0; symmetry < 8; symmetry++) {
+				int outer = transformNeighbourhood(representatives[letter], symmetry);
+				int complement = ~outer & OUTER_BITS;
+
+				for (int centre : { 0, CENTRE_BIT }) {
+					classes[outer | centre] = { count, static_cast<int>(letter) };
+					// 5 - 7 neighbours
+					if (count < 4)
+						classes[complement | centre] = { 8 - count, static_cast<int>(letter) };
+				}
+			}
+		}
+	}
+
+	// 8 neighbours, 0 is already the default
+	classes[OUTER_BITS] = { 8, 0 };
+	classes[OUTER_BITS | CENTRE_BIT] = { 8, 0 };
+	return classes;
+}
+
+// Plane orders tried when compiling the network, the smallest is kept.
+// Centre first splits birth from survival
+static const std::array<std::array<uint8_t, 9>, 4> networkOrders{ {
+	{ 4, 1, 7, 3, 5, 0, 2, 6, 8 },
+	{ 4, 0, 1, 2, 3, 5, 6, 7, 8 },
+	{ 4, 0, 2, 6, 8, 1, 3, 5, 7 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8 }
+} };
+
+static int buildNetworkNode(LifeRule& rule, const std::array<uint8_t, 9>& order,
+	int level, int index) {
+	// Shannon expansion on one plane per level, equal branches collapse
+	// and identical nodes are shared, which keeps the diagram reduced
+	if (level == 9)
+		return rule.getTransition(index) ? 1 : 0;
+
+	int plane = order[level];
+	int low = buildNetworkNode(rule, order, level + 1, index);
+	int high = buildNetworkNode(rule, order, level + 1, index | (1 << plane));
+	if (low == high)
+		return low;
+
+	for (int i = 0; i < rule.numNodes; i++) {
+		const LifeRule::Node& node = rule.network[i];
+		if ((node.plane == plane) && (node.low == low) && (node.high == high))
+			return i + 2;
+	}
+
+	rule.network[rule.numNodes] = { static_cast<uint8_t>(plane),
+		static_cast<uint8_t>(low), static_cast<uint8_t>(high) };
+	return 2 + rule.numNodes++;
+}
+
+static void compileNetwork(LifeRule& rule) {
+	LifeRule best = rule;
+	best.numNodes = LifeRule::MAX_NODES + 1;
+
+	for (const std::array<uint8_t, 9>& order : networkOrders) {
+		rule.numNodes = 0;
+		rule.root = buildNetworkNode(rule, order, 0, 0);
+		if (rule.numNodes < best.numNodes)
+			best = rule;
+	}
+	rule = best;
+}
+
+static int getNumLetters(int count) {
+	return static_cast<int>(strlen(henselLetters[(count <= 4) ? count : (8 - count)]));
+}
+
+static uint16_t getAllLetters(int count) {
+	int numLetters = getNumLetters(count);
+	return static_cast<uint16_t>(numLetters ? ((1 << numLetters) - 1) : 1);
+}
+
+static bool parseCounts(const std::string& text, std::array<uint16_t, 9>& letters) {
+	// Digits 0 - 8, each optionally followed by a '-' and Hensel letters.
+	// Letters select configurations, '-' excludes them instead
+	size_t i = 0;
+	while (i < text.size()) {
+		if (!isdigit(static_cast<unsigned char>(text[i])))
+			return false;
+
+		int count = text[i] - '0';
+		if (count > 8)
+			return false;
+		i++;
+
+		bool exclude = (i < text.size()) && (text[i] == '-');
+		if (exclude)
+			i++;
+
+		const char* validLetters = henselLetters[(count <= 4) ? count : (8 - count)];
+		uint16_t selected = 0;
+		while ((i < text.size()) && islower(static_cast<unsigned char>(text[i]))) {
+			const char* letter = strchr(validLetters, text[i]);
+			if (!letter)
+				return false;
+			selected |= 1 << (letter - validLetters);
+			i++;
+		}
+
+		if (exclude && !selected)
+			return false;
+
+		uint16_t all = getAllLetters(count);
+		if (!selected)
+			selected = all;
+		else if (exclude)
+			selected = all & ~selected;
+
+		letters[count] |= selected;
+	}
+	return true;
+}
+
+bool parseLifeRule(const std::string& text, LifeRule& rule) {
+	static const std::array<NeighbourhoodClass, 512> classes = buildClassTable();
+
+	// Split into birth and survival, in either order, '/' optional
+	std::string birthText;
+	std::string survivalText;
+	std::string* section = nullptr;
+	bool hasBirth = false;
+	bool hasSurvival = false;
+
+	for (char c : text) {
+		if (isspace(static_cast<unsigned char>(c)) || (c == '/'))
+			continue;
+
+		if ((c == 'B') || (c == 'b')) {
+			if (hasBirth)
+				return false;
+			hasBirth = true;
+			section = &birthText;
+		}
+		else if ((c == 'S') || (c == 's')) {
+			if (hasSurvival)
+				return false;
+			hasSurvival = true;
+			section = &survivalText;
+		}
+		else if (section) {
+			section->push_back(c);
+		}
+		else {
+			return false;
+		}
+	}
+
+	std::array<uint16_t, 9> birth{};
+	std::array<uint16_t, 9> survival{};
+	if (!hasBirth || !parseCounts(birthText, birth) || !parseCounts(survivalText, survival))
+		return false;
+
+	LifeRule compiled;
+	memcpy(compiled.label, rule.label, 5);
+
+	for (int count = 0; count < 9; count++) {
+		uint16_t all = getAllLetters(count);
+		if (birth[count] == all)
+			compiled.value |= 1 << count;
+		if (survival[count] == all)
+			compiled.value |= 1 << (count + 9);
+		if ((birth[count] && (birth[count] != all)) || (survival[count] && (survival[count] != all)))
+			compiled.isotropic = true;
+	}
+
+	for (int index = 0; index < 512; index++) {
+		const NeighbourhoodClass& neighbourhood = classes[index];
+		const std::array<uint16_t, 9>& letters = (index & CENTRE_BIT) ? survival : birth;
+		if ((letters[neighbourhood.count] >> neighbourhood.letter) & 1)
+			compiled.table[index >> 6] |= 1ULL << (index & 63);
+	}
+
+	compileNetwork(compiled);
+	rule = compiled;
+	return true;
+}
+
+static void loadLifeRuleFile(const std::string& path) {
+	// One rule per line, a label of up to 4 characters then the rule,
+	// e.g. "TLIF B3/S2-i34q". Lines starting with # are comments
+	std::ifstream file(path);
+	std::string line;
+
+	while (std::getline(file, line) && (userLifeRules.size() < MAX_USER_LIFE_RULES)) {
+		size_t start = line.find_first_not_of(" \t\r");
+		if ((start == std::string::npos) || (line[start] == '#'))
+			continue;
+
+		size_t labelEnd = line.find_first_of(" \t", start);
+		if (labelEnd == std::string::npos)
+			continue;
+
+		LifeRule rule;
+		snprintf(rule.label, 5, "%4.4s", line.substr(start, labelEnd - start).c_str());
+		if (parseLifeRule(line.substr(labelEnd), rule))
+			userLifeRules.push_back(rule);
+		else
+			WARN("Wolfram: invalid Life rule \"%s\" in %s", line.c_str(), path.c_str());
+	}
+}
+
+void loadUserLifeRules() {
+	// Bank shipped with the plugin, then the user's own
+	userLifeRules.clear();
+	loadLifeRuleFile(asset::plugin(pluginInstance, "res/lifeRules.txt"));
+
+	std::string userPath = asset::user("ModularMooch/lifeRules.txt");
+	if (system::exists(userPath))
+		loadLifeRuleFile(userPath);
+}
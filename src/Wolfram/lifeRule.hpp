@@ -0,0 +1,54 @@
+// lifeRule.hpp
+// Part of the Modular Mooch Wolfram module (VCV Rack)
+//
+// GitHub: https://github.com/WesDaMooch/Modular-Mooch-VCV
+//
+// Copyright (c) 2026 Wesley Lawrence Leggo-Morrell
+// License: GPL-3.0-or-later
+
+#pragma once
+#include "../plugin.hpp"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct LifeRule {
+	// A compiled Life-like rule.
+	// Totalistic rules run on the adder kernel using value,
+	// isotropic non-totalistic rules run on the compiled network.
+	char label[5] = "CUST";
+	uint32_t value = 0;		// Birth bits 0 - 8, survival bits 9 - 17
+	bool isotropic = false;
+	// 512 entry transition table, one bit per 3x3 neighbourhood,
+	// filled by parseLifeRule, unused by the built-in rules.
+	// Index bits are read left to right, top to bottom, NW = bit 0, C = bit 4, SE = bit 8
+	std::array<uint64_t, 8> table{};
+
+	// The table compiled to a reduced ordered binary decision diagram,
+	// evaluated as a network of muxes over the nine neighbourhood planes.
+	// Values 0 and 1 are dead and alive, node i is value i + 2,
+	// nodes only refer to values before them
+	struct Node {
+		uint8_t plane;	// Table index bit
+		uint8_t low;
+		uint8_t high;
+	};
+	static constexpr int MAX_NODES = 146;	// Worst case for 9 inputs is 143
+	std::array<Node, MAX_NODES> network{};
+	int numNodes = 0;
+	int root = 0;
+
+	inline bool getTransition(int index) const {
+		return (table[index >> 6] >> (index & 63)) & 1;
+	}
+};
+
+// Compiles B/S notation, e.g. "B3/S23", and Hensel isotropic
+// non-totalistic notation, e.g. "B2-a/S12", returns false if invalid
+bool parseLifeRule(const std::string& text, LifeRule& rule);
+
+// User rule bank, loaded once at plugin init and read only after
+static constexpr int MAX_USER_LIFE_RULES = 64;
+extern std::vector<LifeRule> userLifeRules;
+void loadUserLifeRules();
@@ -0,0 +1,28 @@
+// outputFx.cpp
+// Part of the Modular Mooch Wolfram module (VCV Rack)
+//
+// GitHub: https://github.com/WesDaMooch/Modular-Mooch-VCV
+//
+// Copyright (c) 2026 Wesley Lawrence Leggo-Morrell
+// License: GPL-3.0-or-later
+
+#include "outputFx.hpp"
+
+const char OutputFx::effectLabel[OutputFx::NUM_EFFECTS][5] = {
+	"GAIN",
+	"RISE",
+	"FALL",
+	"FOLD",
+	"XMOD",
+	"SLEW"
+};
+
+const std::array<float, OutputFx::FOLD_TABLE_SIZE + 1> OutputFx::foldTable = OutputFx::buildFoldTable();
+
+std::array<float, OutputFx::FOLD_TABLE_SIZE + 1> OutputFx::buildFoldTable() {
+	// One period of a sine, the extra entry saves a wrap when interpolating
+	std::array<float, FOLD_TABLE_SIZE + 1> table{};
+	for (int i = 0; i <= FOLD_TABLE_SIZE; i++)
+		table[i] = std::sin(2.f * M_PI * i / FOLD_TABLE_SIZE);
+	return table;
+}
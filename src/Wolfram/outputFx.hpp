@@ -0,0 +1,159 @@
+// outputFx.hpp
+// Part of the Modular Mooch Wolfram module (VCV Rack)
+//
+// GitHub: https://github.com/WesDaMooch/Modular-Mooch-VCV
+//
+// Copyright (c) 2026 Wesley Lawrence Leggo-Morrell
+// License: GPL-3.0-or-later
+
+#pragma once
+#include "../plugin.hpp"
+#include <array>
+#include <cmath>
+
+class OutputFx {
+	// Output effect applied to X and Y (0 - 1) before the output stage.
+	// Each effect is its own specialised kernel, picked once through
+	// a function pointer when the effect changes, so no switch per sample.
+	// The amount of effect is set per channel by the Scale params.
+public:
+	enum Effect {
+		GAIN,	// 0 - 10Vpp
+		RISE,	// Slew rise (left = exponential, right = linear)
+		FALL,	// Slew fall (left = exponential, right = linear)
+		FOLD,	// Wavefolding (left = minus, right = plus)
+		XMOD,	// Cross modulation (left = ring, right = amplitude)
+		SLEW,	// Slew rise and fall (left = exponential, right = linear)
+		NUM_EFFECTS
+	};
+	static constexpr int effectDefault = GAIN;
+	static const char effectLabel[NUM_EFFECTS][5];
+
+	using Kernel = void (*)(OutputFx& fx, float* io);
+
+	OutputFx() {
+		setEffect(effectDefault);
+	}
+
+	void setEffect(int newEffect) {
+		effect = rack::clamp(newEffect, 0, NUM_EFFECTS - 1);
+		kernel = kernels[effect];
+		amount = { -1.f, -1.f };
+	}
+
+	int getEffect() {
+		return effect;
+	}
+
+	void setAmount(int channel, float newAmount, float sampleRate, bool audioRate) {
+		// Coefficients are only rebuilt when the amount changes
+		if (newAmount == amount[channel])
+			return;
+
+		amount[channel] = newAmount;
+		float bipolar = (newAmount * 2.f) - 1.f;
+		float depth = std::fabs(bipolar);
+		bool right = bipolar > 0.f;
+
+		// Slew, skewed depth (0 - 1) -> (0 - 10ms) if Audio Rate mode else (0 - 1000ms)
+		float slewMs = depth * depth * (audioRate ? 10.f : 1000.f);
+		float slewSamples = std::fmax(slewMs * 0.001f * sampleRate, 1.f);
+		float expCoef = (slewSamples > 1.f) ? (1.f - std::exp(-1.f / slewSamples)) : 1.f;
+		slewCoef[channel] = right ? 0.f : expCoef;
+		slewStep[channel] = right ? (1.f / slewSamples) : 0.f;
+
+		// Fold
+		foldDrive[channel] = 1.f + (depth * 4.f);
+		foldBias[channel] = bipolar * 0.5f;
+
+		// Cross modulation
+		ringMix[channel] = right ? 0.f : depth;
+		amMix[channel] = right ? depth : 0.f;
+	}
+
+	void reset() {
+		state = {};
+		amount = { -1.f, -1.f };
+	}
+
+	void process(float* io) {
+		kernel(*this, io);
+	}
+
+protected:
+	static constexpr int FOLD_TABLE_SIZE = 512;	// Entries per fold period
+	static const std::array<float, FOLD_TABLE_SIZE + 1> foldTable;
+
+	int effect = effectDefault;
+	Kernel kernel = nullptr;
+
+	std::array<float, 2> amount{};
+	std::array<float, 2> state{};
+	std::array<float, 2> slewCoef{};
+	std::array<float, 2> slewStep{};
+	std::array<float, 2> foldDrive{};
+	std::array<float, 2> foldBias{};
+	std::array<float, 2> ringMix{};
+	std::array<float, 2> amMix{};
+
+	template <int EFFECT>
+	static void processEffect(OutputFx& fx, float* io) {
+		float x = io[0];
+		float y = io[1];
+
+		for (int i = 0; i < 2; i++) {
+			if constexpr (EFFECT == GAIN) {
+				io[i] *= fx.amount[i];
+			}
+			else if constexpr (EFFECT == RISE) {
+				// Exponential (coef) and linear (step) are mutually exclusive,
+				// falling edges pass through
+				float delta = io[i] - fx.state[i];
+				fx.state[i] += std::fmin(delta, (delta * fx.slewCoef[i]) + fx.slewStep[i]);
+				io[i] = fx.state[i];
+			}
+			else if constexpr (EFFECT == FALL) {
+				float delta = io[i] - fx.state[i];
+				fx.state[i] += std::fmax(delta, (delta * fx.slewCoef[i]) - fx.slewStep[i]);
+				io[i] = fx.state[i];
+			}
+			else if constexpr (EFFECT == SLEW) {
+				float delta = io[i] - fx.state[i];
+				float limit = std::fabs(delta * fx.slewCoef[i]) + fx.slewStep[i];
+				fx.state[i] += rack::clamp(delta, -limit, limit);
+				io[i] = fx.state[i];
+			}
+			else if constexpr (EFFECT == FOLD) {
+				float bipolar = (io[i] * 2.f) - 1.f;
+				io[i] = 0.5f + 0.5f * fold((bipolar * fx.foldDrive[i]) + fx.foldBias[i]);
+			}
+			else if constexpr (EFFECT == XMOD) {
+				float self = (i == 0) ? x : y;
+				float other = (i == 0) ? y : x;
+				float ring = ((self * 2.f) - 1.f) * (1.f - fx.ringMix[i] + fx.ringMix[i] * ((other * 2.f) - 1.f));
+				io[i] = (0.5f + 0.5f * ring) * (1.f - fx.amMix[i] + fx.amMix[i] * other);
+			}
+		}
+	}
+
+	static constexpr std::array<Kernel, NUM_EFFECTS> kernels{ {
+		&processEffect<GAIN>,
+		&processEffect<RISE>,
+		&processEffect<FALL>,
+		&processEffect<FOLD>,
+		&processEffect<XMOD>,
+		&processEffect<SLEW>,
+	} };
+
+	static inline float fold(float input) {
+		// Sine folder, sin(pi / 2 * input) read from a table,
+		// one period spans an input of 4
+		float position = (input + 64.f) * (FOLD_TABLE_SIZE * 0.25f);
+		int index = static_cast<int>(position);
+		float fraction = position - index;
+		index &= FOLD_TABLE_SIZE - 1;
+		return foldTable[index] + fraction * (foldTable[index + 1] - foldTable[index]);
+	}
+
+	static std::array<float, FOLD_TABLE_SIZE + 1> buildFoldTable();
+};
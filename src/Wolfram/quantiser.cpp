@@ -0,0 +1,78 @@
+// quantiser.cpp
+// Part of the Modular Mooch Wolfram module (VCV Rack)
+//
+// GitHub: https://github.com/WesDaMooch/Modular-Mooch-VCV
+//
+// Copyright (c) 2026 Wesley Lawrence Leggo-Morrell
+// License: GPL-3.0-or-later
+
+#include "quantiser.hpp"
+
+const std::array<Quantiser::Scale, Quantiser::NUM_SCALES> Quantiser::scale{ {
+	{ "Chromatic",			0xFFF },
+	{ "Major",				0xAB5 },	// 0 2 4 5 7 9 11
+	{ "Minor",				0x5AD },	// 0 2 3 5 7 8 10
+	{ "Harmonic minor",		0x9AD },	// 0 2 3 5 7 8 11
+	{ "Dorian",				0x6AD },	// 0 2 3 5 7 9 10
+	{ "Phrygian",			0x5AB },	// 0 1 3 5 7 8 10
+	{ "Mixolydian",			0x6B5 },	// 0 2 4 5 7 9 10
+	{ "Major pentatonic",	0x295 },	// 0 2 4 7 9
+	{ "Minor pentatonic",	0x4A9 },	// 0 3 5 7 10
+	{ "Blues",				0x4E9 },	// 0 3 5 6 7 10
+	{ "Whole tone",			0x555 },	// 0 2 4 6 8 10
+} };
+
+const char Quantiser::rootName[Quantiser::NUM_ROOTS][3] = {
+	"C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B"
+};
+
+Quantiser::Quantiser() {
+	set(0, 0, 1);
+}
+
+void Quantiser::set(int newScale, int newRoot, int newRange) {
+	newScale = rack::clamp(newScale, 0, NUM_SCALES - 1);
+	newRoot = rack::clamp(newRoot, 0, NUM_ROOTS - 1);
+	newRange = rack::clamp(newRange, 0, NUM_RANGES - 1);
+
+	if ((newScale == scaleIndex) && (newRoot == root) && (newRange == range))
+		return;
+
+	scaleIndex = newScale;
+	root = newRoot;
+	range = newRange;
+
+	buildTable(byteTable.data(), BYTE_LEVELS);
+	buildTable(populationTable.data(), POPULATION_LEVELS);
+}
+
+float Quantiser::quantise(float semitone) const {
+	// Nearest note of the scale, searched one octave either side
+	uint16_t notes = scale[scaleIndex].notes;
+	int octave = static_cast<int>(std::floor(semitone / 12.f));
+	float nearest = 0.f;
+	float nearestDistance = INFINITY;
+
+	for (int i = -12; i < 24; i++) {
+		int degree = ((i - root) % 12 + 12) % 12;
+		if (!((notes >> degree) & 1))
+			continue;
+
+		float note = (octave * 12.f) + i;
+		float distance = std::fabs(note - semitone);
+		if (distance < nearestDistance) {
+			nearestDistance = distance;
+			nearest = note;
+		}
+	}
+	return nearest;
+}
+
+void Quantiser::buildTable(float* table, int levels) {
+	float semitones = (range + 1) * 12.f;
+	for (int i = 0; i < levels; i++) {
+		float semitone = (static_cast<float>(i) / (levels - 1)) * semitones;
+		float note = rack::clamp(quantise(semitone), 0.f, semitones);
+		table[i] = note / 120.f;
+	}
+}
@@ -0,0 +1,65 @@
+// quantiser.hpp
+// Part of the Modular Mooch Wolfram module (VCV Rack)
+//
+// GitHub: https://github.com/WesDaMooch/Modular-Mooch-VCV
+//
+// Copyright (c) 2026 Wesley Lawrence Leggo-Morrell
+// License: GPL-3.0-or-later
+
+#pragma once
+#include "../plugin.hpp"
+#include <array>
+#include <cstdint>
+
+class Quantiser {
+	// Pitch quantiser for the X and Y outputs.
+	// Engine outputs are small integers (8-bit rows or populations),
+	// so every possible output is quantised ahead of time into a table,
+	// quantising is then a single load. Tables are only rebuilt on a setting change.
+public:
+	enum Outputs {
+		OUTPUTS_OFF,
+		OUTPUTS_X,
+		OUTPUTS_Y,
+		OUTPUTS_XY,
+		NUM_OUTPUTS
+	};
+
+	struct Scale {
+		char name[20];
+		uint16_t notes;	// Bit per semitone above the root
+	};
+
+	static constexpr int NUM_SCALES = 11;
+	static const std::array<Scale, NUM_SCALES> scale;
+	static constexpr int NUM_ROOTS = 12;
+	static const char rootName[NUM_ROOTS][3];
+	static constexpr int NUM_RANGES = 5;	// 1 - 5 octaves
+
+	static constexpr int BYTE_LEVELS = 256;			// Wolf rows & columns, Life top row
+	static constexpr int POPULATION_LEVELS = 65;	// Life population
+
+	Quantiser();
+
+	void set(int newScale, int newRoot, int newRange);
+
+	inline float process(int index, int levels) const {
+		// Returns the quantised voltage scaled to 0 - 1 (0 - 10V)
+		return (levels == POPULATION_LEVELS) ? populationTable[index] : byteTable[index];
+	}
+
+	int getScale() const { return scaleIndex; }
+	int getRoot() const { return root; }
+	int getRange() const { return range; }
+
+protected:
+	int scaleIndex = -1;
+	int root = -1;
+	int range = -1;
+
+	std::array<float, BYTE_LEVELS> byteTable{};
+	std::array<float, POPULATION_LEVELS> populationTable{};
+
+	float quantise(float semitone) const;
+	void buildTable(float* table, int levels);
+};
@@ -0,0 +1,547 @@
+// volumeEngine.cpp
+// Part of the Modular Mooch Wolfram module (VCV Rack)
+//
+// GitHub: https://github.com/WesDaMooch/Modular-Mooch-VCV
+//
+// Copyright (c) 2026 Wesley Lawrence Leggo-Morrell
+// License: GPL-3.0-or-later
+
+#include "volumeEngine.hpp"
+
+const char VolumeEngine::modeLabel[VolumeEngine::NUM_MODES][5] = {
+	"CLIP",	// A box bounded by 0s
+	"WRAP",	// 3-torus, every face wraps to its opposite
+};
+
+const std::array<VolumeEngine::Rule, VolumeEngine::NUM_RULES> VolumeEngine::rule{ {
+	// Rules from Carter Bays & Softology, Bays' rules are named
+	// survival low, survival high, birth low, birth high
+	{ "XTAL", 0xAU, 0x7FU },			// Crystal Growth			B1,3/S0-6
+	{ "REPL", 0x2U, 0x0U },				// Single Point Replication	B1/S
+	{ "CLD2", 0x6000U, 0x7FFF000U },	// Clouds 2					B13-14/S12-26
+	{ "CLD1", 0xE6000U, 0x7FFE000U },	// Clouds 1					B13-14,17-19/S13-26
+	{ "ARCH", 0x8U, 0x70U },			// Architecture				B3/S4-6
+	{ "5766", 0x40U, 0xE0U },			// Life 5766				B6/S5-7
+	{ "5655", 0x20U, 0x60U },			// Life 5655				B5/S5-6
+	{ "4644", 0x10U, 0x70U },			// Life 4644				B4/S4-6
+	{ "4555", 0x20U, 0x30U },			// Life 4555				B5/S4-5
+} };
+
+const char VolumeEngine::seedLabel[VolumeEngine::NUM_SEEDS][5] = {
+	"SPOT",	// 2x2x2 block
+	"SLAB",	// Random middle two layers
+	"RNDS",	// Sparse / Half Density Random
+	"CROS",	// 3D plus sign
+	"CORE",	// Random 4x4x4 centre
+	" RND"	// True Random
+};
+
+// Kernel
+// Each layer is summed with its 8 neighbours into a 4-bit box count,
+// three box counts stacked give the 27 cell total including the centre.
+// Survival is looked up at total - 1 so no subtraction is needed.
+// The same source is compiled for one layer per uint64_t
+// and for four layers per AVX2 register
+#if defined(__x86_64__) || defined(__i386__)
+#define VOLUME_AVX2
+typedef uint64_t VolumeLanes __attribute__((vector_size(32)));
+#endif
+
+template <typename V>
+static inline __attribute__((always_inline)) void loadLanes(V& out, const uint64_t* in) {
+	memcpy(&out, in, sizeof(V));
+}
+
+template <typename V>
+static inline __attribute__((always_inline)) void storeLanes(uint64_t* out, const V& in) {
+	memcpy(out, &in, sizeof(V));
+}
+
+template <typename V>
+static inline __attribute__((always_inline)) void splatLanes(V& out, uint64_t value) {
+	uint64_t lanes[sizeof(V) / sizeof(uint64_t)];
+	for (uint64_t& lane : lanes)
+		lane = value;
+	memcpy(&out, lanes, sizeof(V));
+}
+
+template <typename V, bool WRAP>
+static inline __attribute__((always_inline)) void stepVolume(const uint64_t* read, uint64_t* write,
+	uint32_t birth, uint32_t survival) {
+	constexpr int LANES = sizeof(V) / sizeof(uint64_t);
+	constexpr int NUM_LAYERS = VolumeEngine::NUM_LAYERS;
+
+	V zero, ones, leftColumn, rightColumn;
+	splatLanes(zero, 0ULL);
+	splatLanes(ones, ~0ULL);
+	splatLanes(leftColumn, 0x8080808080808080ULL);
+	splatLanes(rightColumn, 0x0101010101010101ULL);
+
+	// Box counts, one padding layer either side
+	uint64_t box[4][NUM_LAYERS + 2];
+
+	for (int z = 0; z < NUM_LAYERS; z += LANES) {
+		V c;
+		loadLanes(c, read + z);
+
+		V w = (c >> 1) & ~leftColumn;
+		V e = (c << 1) & ~rightColumn;
+		if constexpr (WRAP) {
+			w |= (c << 7) & leftColumn;
+			e |= (c >> 7) & rightColumn;
+		}
+
+		// Row sums, 0 - 3
+		V h0 = w ^ c ^ e;
+		V h1 = (w & c) | (e & (w ^ c));
+
+		// Row sums above and below
+		V n0 = h0 << 8;
+		V n1 = h1 << 8;
+		V s0 = h0 >> 8;
+		V s1 = h1 >> 8;
+		if constexpr (WRAP) {
+			n0 |= h0 >> 56;
+			n1 |= h1 >> 56;
+			s0 |= h0 << 56;
+			s1 |= h1 << 56;
+		}
+
+		// Box count, 0 - 9
+		V b0 = n0 ^ h0 ^ s0;
+		V k0 = (n0 & h0) | (s0 & (n0 ^ h0));
+		V t0 = n1 ^ h1 ^ s1;
+		V t1 = (n1 & h1) | (s1 & (n1 ^ h1));
+		V b1 = t0 ^ k0;
+		V t2 = t0 & k0;
+		V b2 = t1 ^ t2;
+		V b3 = t1 & t2;
+
+		storeLanes(&box[0][z + 1], b0);
+		storeLanes(&box[1][z + 1], b1);
+		storeLanes(&box[2][z + 1], b2);
+		storeLanes(&box[3][z + 1], b3);
+	}
+
+	for (int k = 0; k < 4; k++) {
+		box[k][0] = WRAP ? box[k][NUM_LAYERS] : 0;
+		box[k][NUM_LAYERS + 1] = WRAP ? box[k][1] : 0;
+	}
+
+	for (int z = 0; z < NUM_LAYERS; z += LANES) {
+		// Below + centre layer, 0 - 18
+		std::array<V, 5> sum;
+		V carry = zero;
+		for (int k = 0; k < 4; k++) {
+			V a, b;
+			loadLanes(a, &box[k][z]);
+			loadLanes(b, &box[k][z + 1]);
+			sum[k] = a ^ b ^ carry;
+			carry = (a & b) | (carry & (a ^ b));
+		}
+		sum[4] = carry;
+
+		// + above layer, 0 - 27
+		carry = zero;
+		for (int k = 0; k < 4; k++) {
+			V a;
+			loadLanes(a, &box[k][z + 2]);
+			V total = sum[k] ^ a ^ carry;
+			carry = (sum[k] & a) | (carry & (sum[k] ^ a));
+			sum[k] = total;
+		}
+		sum[4] ^= carry;
+
+		// Each total picks survival or birth by the centre cell,
+		// then the total selects through a mux tree
+		V centre;
+		loadLanes(centre, read + z);
+
+		std::array<V, 32> level;
+		for (int k = 0; k < 32; k++) {
+			bool survive = (k > 0) && ((survival >> (k - 1)) & 1);
+			bool born = (birth >> k) & 1;
+			if (survive)
+				level[k] = born ? ones : centre;
+			else
+				level[k] = born ? ~centre : zero;
+		}
+
+		for (int bit = 0, width = 16; bit < 5; bit++, width >>= 1) {
+			for (int k = 0; k < width; k++) {
+				V a = level[2 * k];
+				level[k] = a ^ ((a ^ level[(2 * k) + 1]) & sum[bit]);
+			}
+		}
+
+		storeLanes(write + z, level[0]);
+	}
+}
+
+template <bool WRAP>
+static void stepVolumePortable(const uint64_t* read, uint64_t* write, uint32_t birth, uint32_t survival) {
+	stepVolume<uint64_t, WRAP>(read, write, birth, survival);
+}
+
+#ifdef VOLUME_AVX2
+template <bool WRAP>
+__attribute__((target("avx2")))
+static void stepVolumeAvx2(const uint64_t* read, uint64_t* write, uint32_t birth, uint32_t survival) {
+	stepVolume<VolumeLanes, WRAP>(read, write, birth, survival);
+}
+#endif
+
+VolumeEngine::VolumeEngine() {
+	memcpy(engineLabel, "CUBE", 5);
+	setKernel();
+	seedVolume(volumeBuffer[readHead]);
+	updateDisplay(false);
+}
+
+bool VolumeEngine::hasAvx2() {
+#ifdef VOLUME_AVX2
+	static const bool avx2 = __builtin_cpu_supports("avx2");
+	return avx2;
+#else
+	return false;
+#endif
+}
+
+void VolumeEngine::setKernel() {
+#ifdef VOLUME_AVX2
+	if (hasAvx2()) {
+		kernel = (modeIndex == 1) ? &stepVolumeAvx2<true> : &stepVolumeAvx2<false>;
+		return;
+	}
+#endif
+	kernel = (modeIndex == 1) ? &stepVolumePortable<true> : &stepVolumePortable<false>;
+}
+
+void VolumeEngine::updateDisplay(bool advance, size_t length) {
+	playheadsDirty = true;
+	if (advance)
+		advanceHeads(length);
+
+	displayMatrix = transformDisplay(volumeBuffer[getScrubHead()][slice]);
+
+	// Count living cells in the slice
+	population = __builtin_popcountll(displayMatrix);
+	displayMatrixUpdated = true;
+}
+
+void VolumeEngine::inject(int inject, bool sync) {
+	// Cells are added to or removed from the visible slice
+	uint64_t& matrix = volumeBuffer[sync ? writeHead : readHead][slice];
+	bool addCell = (inject > 0);
+	int steps = inject < 0 ? -inject : inject;
+
+	for (int step = 0; step < steps; step++) {
+		uint64_t targetMask = addCell ? ~matrix : matrix;
+
+		// Count target bits
+		int targetCount = __builtin_popcountll(targetMask);
+		if (targetCount == 0)
+			break;
+
+		// Random target index
+		int target = rack::random::get<uint32_t>() % targetCount;
+
+		uint64_t mask = targetMask;
+		while (target--)
+			mask &= (mask - 1);
+
+		uint64_t bitMask = mask & -mask;
+
+		matrix = addCell ? (matrix | bitMask) : (matrix & ~bitMask);
+	}
+}
+
+void VolumeEngine::updateMenuParams(const EngineMenuParams& p) {
+	// Rule
+	int newRuleSelect = updateSelect(p.menuDelta[EngineMenuParams::RULE_DELTA],
+		p.menuReset[EngineMenuParams::RULE_RESET],
+		ruleSelect, ruleDefault, NUM_RULES);
+	setRuleSelect(newRuleSelect);
+
+	// Seed
+	int newSeedSelect = updateSelect(p.menuDelta[EngineMenuParams::SEED_DELTA],
+		p.menuReset[EngineMenuParams::SEED_RESET],
+		seedIndex, seedDefault, NUM_SEEDS);
+	setSeed(newSeedSelect);
+
+	// Mode
+	int newModeSelect = updateSelect(p.menuDelta[EngineMenuParams::MODE_DELTA],
+		p.menuReset[EngineMenuParams::MODE_RESET],
+		modeIndex, modeDefault, NUM_MODES);
+	setMode(newModeSelect);
+}
+
+void VolumeEngine::process(const EngineCoreParams& p, EngineOutput& out) {
+
+	bool refreshDisplay = p.step;
+	bool syncStep = p.sync && p.step;
+	setPlayheadLengths(p);
+	if (updateScrub(p))
+		refreshDisplay = true;
+	if (updateTransform(p))
+		refreshDisplay = true;
+	generate = rack::random::get<float>() < p.probability;
+
+	if (!p.sync || (syncStep))
+		setRuleCv(p.ruleCv);
+
+	bool injectOccured = (p.inject != 0);
+	if (injectOccured && p.sync)
+		injectPending += p.inject;
+
+	// Non-sync inject
+	if (injectOccured && !p.sync) {
+		inject(p.inject, p.sync);
+		refreshDisplay = true;
+	}
+
+	// Reset
+	bool seedReset = (p.miniMenuChanged && generate) && !p.sync;
+
+	if (p.miniMenuChanged && p.sync)
+		seedResetPending = true;
+
+	if (p.reset && p.sync)
+		resetPending = true;
+
+	bool resetStep = ((p.reset || seedReset) && !p.sync) || ((resetPending || seedResetPending) && syncStep);
+	if (resetStep) {
+		if (generate) {
+			seedVolume(volumeBuffer[p.sync ? writeHead : readHead]);
+			generate = false;
+		}
+		else if (!seedResetPending) {
+			if (p.sync) {
+				writeHead = 0;
+				playheadResetPending = true;
+			}
+			else {
+				readHead = 0;
+				writeHead = 1;
+				resetPlayheads();
+			}
+		}
+		resetPending = false;
+		seedResetPending = false;
+		refreshDisplay = true;
+	}
+
+	// Per cell probability, every step but a reset generates
+	if (p.cellProbability)
+		generate = !resetStep;
+
+	// Generate
+	if (generate && p.step) {
+		kernel(volumeBuffer[readHead].data(), volumeBuffer[writeHead].data(),
+			rule[ruleIndex].birth, rule[ruleIndex].survival);
+		if (p.cellProbability) {
+			for (int i = 0; i < NUM_LAYERS; i++)
+				volumeBuffer[writeHead][i] = mux<uint64_t>(getProbabilityMask(p.probability), volumeBuffer[readHead][i], volumeBuffer[writeHead][i]);
+		}
+		refreshDisplay = true;
+	}
+
+	// Sync inject
+	if (injectPending && syncStep) {
+		inject(injectPending, p.sync);
+		injectPending = 0;
+	}
+
+	// Slice, OFFSET picks the layer and the expander's view CV moves it
+	int newSlice = (p.offset + static_cast<int>(std::round(p.viewOffset * NUM_LAYERS)) + (2 * NUM_LAYERS)) % NUM_LAYERS;
+	if ((!p.sync && (slice != newSlice)) || syncStep) {
+		slice = newSlice;
+		refreshDisplay = true;
+	}
+
+	// Update
+	if (refreshDisplay)
+		updateDisplay(p.step, p.length);
+
+	// Output
+	// X - Returns the slice population (number of alive cells) scaled to 0 - 1
+	out.x = population * xVoltageScaler;
+	out.xIndex = population;
+	out.xLevels = 65;
+
+	// Y - Returns the 64-bit number slice scaled to 0 - 1
+	out.y = displayMatrix * yVoltageScaler;
+	out.yIndex = static_cast<int>(displayMatrix >> 56);	// Top row, when quantised
+	out.yLevels = 256;
+
+	// X Pulse - True if the slice population has grown
+	if (displayMatrixUpdated && (population > prevPopulation))
+		out.xPulse = true;
+	prevPopulation = population;
+
+	// Y Pulse - True if the slice becomes stagnant (no change occurs),
+	// also true if output repeats while looping
+	if (displayMatrixUpdated && (displayMatrix == prevOutputMatrix))
+		out.yPulse = true;
+	prevOutputMatrix = displayMatrix;
+
+	// Mode LED brightness
+	out.modeLED = static_cast<float>(modeIndex) * modesScaler;
+
+	out.matrix = displayMatrix;
+	displayMatrixUpdated = false;
+
+	if (updatePlayheads(p))
+		renderPlayheads(p);
+	copyPlayheads(p, out);
+}
+
+void VolumeEngine::renderPlayheads(const EngineCoreParams& p) {
+	// Each extra playhead renders the same slice from its own frame
+	for (int i = 0; i < p.numPlayheads; i++) {
+		uint64_t matrix = volumeBuffer[getPlayheadFrame(p, i)][slice];
+
+		int framePopulation = __builtin_popcountll(matrix);
+		playheadOutput[i].x = framePopulation * xVoltageScaler;
+		playheadOutput[i].xIndex = framePopulation;
+		playheadOutput[i].y = matrix * yVoltageScaler;
+		playheadOutput[i].yIndex = static_cast<int>(matrix >> 56);
+	}
+}
+
+void VolumeEngine::reset() {
+	volumeBuffer = {};
+	setBufferFrame(0, 0, true);
+	setReadHead(0);
+	setWriteHead(1);
+	setRuleSelect(ruleDefault);
+	setSeed(seedDefault);
+	setMode(modeDefault);
+	seedVolume(volumeBuffer[readHead]);
+	updateDisplay(false);
+}
+
+// Save setters
+void VolumeEngine::setBufferFrame(uint64_t newFrame, int index,
+	bool setDisplayMatrix) {
+	// Frames are the visible slice, the whole volume is saved separately
+	if (setDisplayMatrix)
+		displayMatrix = newFrame;
+	else if ((index >= 0) && (index < MAX_SEQUENCE_LENGTH))
+		volumeBuffer[index][slice] = newFrame;
+}
+
+void VolumeEngine::onRuleChange() {
+	ruleIndex = rack::clamp(ruleSelect + ruleCv, 0, NUM_RULES - 1);
+}
+
+void VolumeEngine::setRuleSelect(int newRule) {
+	ruleSelect = rack::clamp(newRule, 0, NUM_RULES - 1);
+	onRuleChange();
+}
+
+void VolumeEngine::setRuleCv(float newRuleCv) {
+	ruleCv = static_cast<int>(std::round(newRuleCv * NUM_RULES));
+	onRuleChange();
+}
+
+void VolumeEngine::setSeed(int newSeed) {
+	seedIndex = rack::clamp(newSeed, 0, NUM_SEEDS - 1);
+}
+
+void VolumeEngine::setMode(int newMode) {
+	modeIndex = rack::clamp(newMode, 0, NUM_MODES - 1);
+	setKernel();
+}
+
+// Save getters
+uint64_t VolumeEngine::getBufferFrame(int index,
+	bool getDisplayMatrix,
+	bool getDisplayMatrixSave) {
+
+	if (getDisplayMatrix || getDisplayMatrixSave)
+		return displayMatrix;
+	else if ((index >= 0) && (index < MAX_SEQUENCE_LENGTH))
+		return volumeBuffer[index][slice];
+	else
+		return 0;
+}
+
+int VolumeEngine::getRuleSelect() {
+	return ruleSelect;
+}
+
+int VolumeEngine::getSeed() {
+	return seedIndex;
+}
+
+int VolumeEngine::getMode() {
+	return modeIndex;
+}
+
+// Layers
+void VolumeEngine::setFrameLayer(uint64_t newLayer, int frame, int layer) {
+	if ((frame >= 0) && (frame < MAX_SEQUENCE_LENGTH) && (layer >= 0) && (layer < NUM_LAYERS))
+		volumeBuffer[frame][layer] = newLayer;
+}
+
+uint64_t VolumeEngine::getFrameLayer(int frame, int layer) {
+	if ((frame >= 0) && (frame < MAX_SEQUENCE_LENGTH) && (layer >= 0) && (layer < NUM_LAYERS))
+		return volumeBuffer[frame][layer];
+	return 0;
+}
+
+void VolumeEngine::seedVolume(Volume& volume) {
+	volume = {};
+
+	switch (seedIndex) {
+	case 0:
+		// 2x2x2 block
+		volume[3] = 0x1818000000ULL;
+		volume[4] = 0x1818000000ULL;
+		break;
+	case 1:
+		// Random middle two layers
+		volume[3] = rack::random::get<uint64_t>();
+		volume[4] = rack::random::get<uint64_t>();
+		break;
+	case 2:
+		// Sparse / half density random
+		for (uint64_t& layer : volume)
+			layer = rack::random::get<uint64_t>() & rack::random::get<uint64_t>();
+		break;
+	case 3:
+		// 3D plus sign
+		volume[3] = 0x1000000000ULL;
+		volume[4] = 0x103810000000ULL;
+		volume[5] = 0x1000000000ULL;
+		break;
+	case 4:
+		// Random 4x4x4 centre
+		for (int i = 2; i < 6; i++)
+			volume[i] = rack::random::get<uint64_t>() & 0x3C3C3C3C0000ULL;
+		break;
+	default:
+		// True random
+		for (uint64_t& layer : volume)
+			layer = rack::random::get<uint64_t>();
+		break;
+	}
+}
+
+// UI getters
+void VolumeEngine::getRuleActiveLabel(char out[5]) {
+	memcpy(out, rule[ruleIndex].label, 5);
+}
+
+void VolumeEngine::getRuleSelectLabel(char out[5]) {
+	memcpy(out, rule[ruleSelect].label, 5);
+}
+
+void VolumeEngine::getSeedLabel(char out[5]) {
+	memcpy(out, seedLabel[seedIndex], 5);
+}
+
+void VolumeEngine::getModeLabel(char out[5]) {
+	memcpy(out, modeLabel[modeIndex], 5);
+}
@@ -0,0 +1,107 @@
+// volumeEngine.hpp
+// Part of the Modular Mooch Wolfram module (VCV Rack)
+//
+// GitHub: https://github.com/WesDaMooch/Modular-Mooch-VCV
+//
+// Copyright (c) 2026 Wesley Lawrence Leggo-Morrell
+// License: GPL-3.0-or-later
+
+#pragma once
+#include "algoEngine.hpp"
+
+class VolumeEngine final : public AlgoEngine {
+	// 3D outer-totalistic Life on an 8x8x8 volume, 26 neighbours.
+	// Each layer is one uint64_t laid out as the 8x8 board,
+	// the display and outputs show one slice picked by OFFSET
+	// and the expander's view CV
+public:
+	VolumeEngine();
+
+	static constexpr const char* menuName = "3D Life";
+
+	void updateDisplay(bool advance, size_t length = 8) override;
+	void updateMenuParams(const EngineMenuParams& p) override;
+
+	void process(const EngineCoreParams& p, EngineOutput& out) override;
+
+	void reset() override;
+
+	// Save setters
+	void setBufferFrame(uint64_t newFrame, int index,
+		bool setDisplayMatrix = false) override;
+
+	void setRuleSelect(int newRule) override;
+	void setRuleCv(float newRuleCv) override;
+	void setSeed(int newSeed) override;
+	void setMode(int newMode) override;
+
+	// Save getters
+	uint64_t getBufferFrame(int index,
+		bool getDisplayMatrix = false,
+		bool getDisplayMatrixSave = false) override;
+
+	int getRuleSelect() override;
+	int getSeed() override;
+	int getMode() override;
+
+	// Layers
+	static constexpr int NUM_LAYERS = 8;
+
+	void setFrameLayer(uint64_t newLayer, int frame, int layer);
+	uint64_t getFrameLayer(int frame, int layer);
+
+	// UI getters
+	void getRuleActiveLabel(char out[5]) override;
+	void getRuleSelectLabel(char out[5]) override;
+	void getSeedLabel(char out[5]) override;
+	void getModeLabel(char out[5]) override;
+
+protected:
+	struct Rule {
+		char label[5];
+		uint32_t birth;		// Neighbour counts 0 - 26
+		uint32_t survival;
+	};
+
+	using Volume = std::array<uint64_t, NUM_LAYERS>;
+	std::array<Volume, MAX_SEQUENCE_LENGTH> volumeBuffer{};
+	int slice = 4;
+
+	static constexpr int NUM_MODES = 2;
+	static const char modeLabel[NUM_MODES][5];
+	static constexpr int modeDefault = 1;
+	int modeIndex = modeDefault;
+
+	static constexpr int NUM_RULES = 9;
+	static const std::array<Rule, NUM_RULES> rule;
+	static constexpr int ruleDefault = 8;
+	int ruleSelect = ruleDefault;
+	int ruleCv = 0;
+	int ruleIndex = ruleDefault;
+
+	static constexpr int NUM_SEEDS = 6;
+	static const char seedLabel[NUM_SEEDS][5];
+	static constexpr int seedDefault = 4;
+	int seedIndex = seedDefault;
+
+	int population = 0;
+	int prevPopulation = 0;
+	uint64_t prevOutputMatrix = 0;
+
+	static constexpr float xVoltageScaler = 1.f / 64.f;
+	static constexpr float yVoltageScaler = 1.f / UINT64_MAX;
+	static constexpr float modesScaler = 1.f / (static_cast<float>(NUM_MODES) - 1.f);
+
+	// Kernel, picked once per mode and instruction set,
+	// AVX2 is used when the CPU has it
+	using Kernel = void (*)(const uint64_t* read, uint64_t* write, uint32_t birth, uint32_t survival);
+	Kernel kernel = nullptr;
+	static bool hasAvx2();
+	void setKernel();
+
+	void inject(int inject, bool sync) override;
+	void renderPlayheads(const EngineCoreParams& p);
+	void onRuleChange() override;
+
+	void seedVolume(Volume& volume);
+};
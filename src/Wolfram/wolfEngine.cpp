@@ -14,34 +14,75 @@ const char WolfEngine::modeLabel[WolfEngine::NUM_MODES][5] = {
 	"RAND"
 };
 
+const std::array<WolfEngine::ExtendedRule, WolfEngine::NUM_EXTENDED_RULES> WolfEngine::extendedRule{ {
+	// Totalistic, codes from A New Kind of Science
+	{ "T 20", TOTALISTIC, 20 },			// Class 4, localised structures
+	{ "T 52", TOTALISTIC, 52 },			// Class 4
+	{ "T 10", TOTALISTIC, 10 },			// Odd sums
+	{ "T 26", TOTALISTIC, 26 },
+	{ "T 44", TOTALISTIC, 44 },
+	{ "T  6", TOTALISTIC, 6 },
+	{ "T 12", TOTALISTIC, 12 },
+	{ "T 50", TOTALISTIC, 50 },
+	// Outer totalistic
+	{ "O522", OUTER_TOTALISTIC, 522 },	// B13/S4
+	{ "O366", OUTER_TOTALISTIC, 366 },	// B123/S013
+	{ "O114", OUTER_TOTALISTIC, 114 },	// B14/S01
+	{ "O586", OUTER_TOTALISTIC, 586 },	// B13/S14
+	{ "O186", OUTER_TOTALISTIC, 186 },	// B134/S02
+	{ " O22", OUTER_TOTALISTIC, 22 },	// B124
+	{ "O162", OUTER_TOTALISTIC, 162 },	// B1/S02
+	{ "O610", OUTER_TOTALISTIC, 610 },	// B1/S014
+	// Radius 2
+	{ "MAJ5", RADIUS_2, 0xFEE8E880U },	// Majority of 5
+	{ "PAR5", RADIUS_2, 0x96696996U },	// Parity of 5
+	{ "XOR2", RADIUS_2, 0x5555AAAAU },	// ll xor rr
+	{ " 30W", RADIUS_2, 0x0505FAFAU },	// Rule 30 on every other cell, ll xor (c or rr)
+	{ " 30X", RADIUS_2, 0xA95603FCU },	// Rule 30 xor (ll and rr)
+} };
+
 WolfEngine::WolfEngine() {
 	memcpy(engineLabel, "WOLF", 5);
+	setMaxLength(rowBuffer.size());
 	rowBuffer[readHead] = seed;
 	updateDisplay(false);
 }
 
 void WolfEngine::updateDisplay(bool step, size_t length) {
+	playheadsDirty = true;
 	if (step) {
 		advanceHeads(length);
 		internalDisplayMatrix <<= 8;	// Shift matrix up
 	}
 
+	// Wide worlds keep the visible window in the sequence buffer,
+	// the offset has already moved the window
+	if (worldSize > 8)
+		rowBuffer[readHead] = getWindow(worldBuffer[readHead]);
+	int displayOffset = (worldSize > 8) ? 0 : offset;
+
 	internalDisplayMatrix &= ~0xFFULL;
 	internalDisplayMatrix |= rowBuffer[readHead];
 
-	// Apply offset
-	uint64_t tempMatrix = 0;
-	for (int i = 0; i < 8; i++) {
-		uint8_t row = (internalDisplayMatrix >> (i * 8)) & 0xFFULL;
-		tempMatrix |= uint64_t(applyOffset(row, offset)) << (i * 8);
+	displayMatrix = rotateRows(internalDisplayMatrix, displayOffset);
+
+	// Scrubbing builds the display from the eight rows up to the scrub head
+	if (scrubOffset > 0) {
+		size_t head = getScrubHead();
+		displayMatrix = 0;
+		for (size_t i = 0; i < 8; i++) {
+			uint8_t row = getViewRow((head + (8 * scrubLength) - i) % scrubLength);
+			displayMatrix |= uint64_t(row) << (i * 8);
+		}
 	}
-	displayMatrix = tempMatrix;
+	displayMatrix = transformDisplay(displayMatrix);
 	displayMatrixUpdated = true;
 }
 
 void WolfEngine::inject(int inject, bool sync) {
 	size_t head = sync ? writeHead : readHead;
-	uint8_t row = rowBuffer[head];
+	bool wideWorld = worldSize > 8;
+	uint8_t row = wideWorld ? getWindow(worldBuffer[head]) : rowBuffer[head];
 	bool addCell = (inject > 0);
 	int steps = inject < 0 ? -inject : inject;
 	
@@ -49,7 +90,7 @@ void WolfEngine::inject(int inject, bool sync) {
 		
 		// Check if row is already full or empty
 		if ((addCell && (row == UINT8_MAX)) || (!addCell && (row == 0)))
-			return;
+			break;
 
 		// Flip row if removing cells
 		uint8_t targetMask = addCell ? ~row : row; 
@@ -57,7 +98,7 @@ void WolfEngine::inject(int inject, bool sync) {
 		// Count target bits
 		int targetCount = __builtin_popcount(targetMask);	
 		if (targetCount == 0)
-			return;
+			break;
 
 		// Random target index
 		int target = rack::random::get<uint8_t>() % targetCount;	
@@ -70,17 +111,20 @@ void WolfEngine::inject(int inject, bool sync) {
 		uint8_t bitMask = mask & -mask;
 
 		row = addCell ? (row | bitMask) : (row & ~bitMask);
-		rowBuffer[head] = row;
 	}
+
+	// Wide worlds inject into the visible window
+	if (wideWorld)
+		setWindow(worldBuffer[head], row);
+	else
+		rowBuffer[head] = row;
 }
 
 void WolfEngine::updateMenuParams(const EngineMenuParams& p) {
 	// Rule
-	int newRuleSelect = ruleSelect;
-	if (p.menuReset[EngineMenuParams::RULE_RESET])
-		newRuleSelect = ruleDefault;
-	else if (p.menuDelta[EngineMenuParams::RULE_DELTA] != 0)
-		newRuleSelect = static_cast<uint8_t>(ruleSelect + p.menuDelta[EngineMenuParams::RULE_DELTA]);
+	int newRuleSelect = updateSelect(p.menuDelta[EngineMenuParams::RULE_DELTA],
+		p.menuReset[EngineMenuParams::RULE_RESET],
+		ruleSelect, ruleDefault, NUM_RULES);
 	setRuleSelect(newRuleSelect);
 
 	// Seed
@@ -98,14 +142,19 @@ void WolfEngine::updateMenuParams(const EngineMenuParams& p) {
 	setMode(newModeSelect);
 };
 
-void WolfEngine::process(const EngineCoreParams& p,
-	float* xOut, float* yOut, 
-	bool* xPulse, bool* yPulse, 
-	float* modeLED) {
+void WolfEngine::process(const EngineCoreParams& p, EngineOutput& out) {
+	// A new history depth from the UI, heads past it wrap
+	if (rowBuffer.update())
+		setMaxLength((worldSize > 8) ? MAX_SEQUENCE_LENGTH : rowBuffer.size());
 
 	// Sequencer
 	bool refreshDisplay = p.step;
 	bool syncStep = p.sync && p.step;
+	setPlayheadLengths(p);
+	if (updateScrub(p))
+		refreshDisplay = true;
+	if (updateTransform(p))
+		refreshDisplay = true;
 	generate = rack::random::get<float>() < p.probability;
 
 	if (!p.sync || (syncStep))
@@ -130,20 +179,27 @@ void WolfEngine::process(const EngineCoreParams& p,
 	if (p.reset && p.sync)
 		resetPending = true;
 
-	if (((p.reset || seedReset) && !p.sync) || ((resetPending || seedResetPending) && syncStep)) {
+	bool resetStep = ((p.reset || seedReset) && !p.sync) || ((resetPending || seedResetPending) && syncStep);
+	if (resetStep) {
 		if (generate) {
 			int head = p.sync ? writeHead : readHead;
 			uint8_t resetRow = randSeed ? rack::random::get<uint8_t>() : seed;
-			rowBuffer[head] = resetRow;
+			if (worldSize > 8)
+				seedWorld(worldBuffer[head], resetRow);
+			else
+				rowBuffer[head] = resetRow;
+			previousRow = {};
 			generate = false;
 		}
 		else if (!seedResetPending) {
 			if (p.sync) {
 				writeHead = 0;
+				playheadResetPending = true;
 			}
 			else {
 				readHead = 0;
 				writeHead = 1;
+				resetPlayheads();
 			}
 		}
 		resetPending = false;
@@ -151,40 +207,64 @@ void WolfEngine::process(const EngineCoreParams& p,
 		refreshDisplay = true;
 	}
 
-	// Generate
-	if (generate && p.step) {
-		// One Dimensional Cellular Automata
-		uint8_t readRow = rowBuffer[readHead];
-		uint8_t writeRow = 0;
-
-		// Clip
-		uint8_t left = readRow >> 1;
-		uint8_t right = readRow << 1;
+	// Per cell probability generates on every step but a reset,
+	// the probability then picks which cells update
+	if (p.cellProbability)
+		generate = !resetStep;
 
-		if (modeIndex == 1) {
-			// Wrap
-			left = (readRow >> 1) | (readRow << 7);
-			right = (readRow << 1) | (readRow >> 7);
+	// Generate
+	if (generate && p.step && (worldSize > 8)) {
+		WideRow current = worldBuffer[readHead];
+		if (reversible) {
+			// Second order, reversing swaps the current and previous rows
+			// so the same step runs the sequence backwards.
+			// Every cell updates, a per cell probability would break reversal
+			const WideRow& ruleRow = p.reverse ? previousRow : current;
+			const WideRow& xorRow = p.reverse ? current : previousRow;
+			WideRow nextRow{};
+			stepWorld(ruleRow, nextRow);
+			for (int i = 0; i < worldWords; i++)
+				nextRow[i] ^= xorRow[i];
+
+			worldBuffer[writeHead] = p.reverse ? previousRow : nextRow;
+			previousRow = p.reverse ? nextRow : current;
 		}
-		else if (modeIndex == 2) {
-			// Random
-			left |= rack::random::get<bool>() << 7;
-			right |= rack::random::get<bool>();
+		else {
+			stepWorld(current, worldBuffer[writeHead]);
+			if (p.cellProbability) {
+				for (int i = 0; i < worldWords; i++)
+					worldBuffer[writeHead][i] = mux<uint64_t>(getProbabilityMask(p.probability), current[i], worldBuffer[writeHead][i]);
+			}
 		}
-
-		for (int col = 0; col < 8; col++) {
-			uint8_t leftBit = (left >> col) & 1;
-			uint8_t currentBit = (readRow >> col) & 1;
-			uint8_t rightBit = (right >> col) & 1;
-
-			uint8_t tag = (leftBit << 2) | (currentBit << 1) | rightBit;
-			uint8_t newBit = (rule >> tag) & 1;
-
-			writeRow |= newBit << col;
+		refreshDisplay = true;
+	}
+	else if (generate && p.step) {
+		uint8_t current = rowBuffer[readHead];
+		if (reversible) {
+			uint8_t previous = static_cast<uint8_t>(previousRow[0]);
+			uint8_t ruleRow = p.reverse ? previous : current;
+			uint8_t xorRow = p.reverse ? current : previous;
+			uint8_t nextRow = stepRow(ruleRow) ^ xorRow;
+
+			rowBuffer[writeHead] = p.reverse ? previous : nextRow;
+			previousRow[0] = p.reverse ? nextRow : current;
+		}
+		else {
+			uint8_t nextRow = stepRow(current);
+			if (p.cellProbability)
+				nextRow = mux<uint8_t>(static_cast<uint8_t>(getProbabilityMask(p.probability)), current, nextRow);
+			rowBuffer[writeHead] = nextRow;
 		}
-		rowBuffer[writeHead] = writeRow;
 		refreshDisplay = true;
 	}
+	else if (reversible && p.step) {
+		// Skipped steps replay the buffer,
+		// the last two rows played carry on as the state
+		if (worldSize > 8)
+			previousRow = worldBuffer[readHead];
+		else
+			previousRow[0] = rowBuffer[readHead];
+	}
 
 	// Sync inject
 	if (injectPending && syncStep) {
@@ -192,10 +272,18 @@ void WolfEngine::process(const EngineCoreParams& p,
 		injectPending = 0;
 	}
 
-	// Offset
+	// Offset, wide worlds move the visible window instead,
+	// OFFSET in eighths of the world and the expander's view CV across all of it
 	int newOffset = p.offset - 4;
-	if ((!p.sync && (offset != newOffset)) || syncStep) {
+	int newViewX = 0;
+	if (worldSize > 8) {
+		int viewCv = static_cast<int>(std::round(p.viewOffset * worldSize));
+		newViewX = (((p.offset * worldSize) / 8) + viewCv + worldSize) % worldSize;
+	}
+	bool viewChanged = (offset != newOffset) || (viewX != newViewX);
+	if ((!p.sync && viewChanged) || syncStep) {
 		offset = newOffset;
+		viewX = newViewX;
 		refreshDisplay = true;
 	}
 
@@ -206,34 +294,64 @@ void WolfEngine::process(const EngineCoreParams& p,
 	// Render output
 	// X - Returns bottom row of the display matrix scaled to 0-1	
 	uint8_t firstRow = displayMatrix & 0xFFULL;
-	*xOut = firstRow * voltageScaler;
+	out.x = firstRow * voltageScaler;
+	out.xIndex = firstRow;
+	out.xLevels = 256;
 
 	// Y - Returns right column of the display matrix scaled to 0-1
 	// Output matrix is flipped when drawn (right -> left, left <- right)
 	uint64_t yMask = 0x0101010101010101ULL;
 	uint64_t column = displayMatrix & yMask;
 	uint8_t yColumn = static_cast<uint8_t>((column * 0x8040201008040201ULL) >> 56);
-	*yOut = yColumn * voltageScaler;
+	out.y = yColumn * voltageScaler;
+	out.yIndex = yColumn;
+	out.yLevels = 256;
 
 	// X Pulse - Returns true if bottom left cell state of displayMatrix is living
 	bool bottonLeftCellState = ((displayMatrix & 0xFFULL) >> 7) & 1;
 	if (displayMatrixUpdated && bottonLeftCellState)
-		*xPulse = true;
+		out.xPulse = true;
 
 	// Y Pulse - Returns true if top right cell state	of displayMatrix is living
 	bool topRightCellState = ((displayMatrix >> 56) & 0xFFULL) & 1;
 	if (displayMatrixUpdated && topRightCellState)
-		*yPulse = true;
+		out.yPulse = true;
 
 	// Mode LED brightness
-	*modeLED = static_cast<float>(modeIndex) * modeScaler;
+	out.modeLED = static_cast<float>(modeIndex) * modeScaler;
 
+	out.matrix = displayMatrix;
 	displayMatrixUpdated = false;
+
+	if (updatePlayheads(p))
+		renderPlayheads(p);
+	copyPlayheads(p, out);
+}
+
+void WolfEngine::renderPlayheads(const EngineCoreParams& p) {
+	// Each extra playhead renders the same outputs as the main head
+	// from its own frame, no extra generation
+	size_t length = rack::clamp(static_cast<int>(p.length), 1, static_cast<int>(maxLength));
+	for (int i = 0; i < p.numPlayheads; i++) {
+		size_t frame = getPlayheadFrame(p, i);
+		uint8_t row = getViewRow(frame);
+
+		// Y column is made from the previous eight frames, newest as the MSB
+		uint8_t column = 0;
+		for (size_t j = 0; j < 8; j++) {
+			uint8_t historyRow = getViewRow((frame + (8 * length) - j) % length);
+			column |= (historyRow & 1) << (7 - j);
+		}
+
+		playheadOutput[i].x = row * voltageScaler;
+		playheadOutput[i].xIndex = row;
+		playheadOutput[i].y = column * voltageScaler;
+		playheadOutput[i].yIndex = column;
+	}
 }
 
 void WolfEngine::reset() {
-	for (int i = 0; i < MAX_SEQUENCE_LENGTH; i++)
-		setBufferFrame(0, i);
+	std::fill(rowBuffer.begin(), rowBuffer.end(), 0);
 
 	setBufferFrame(0, 0, true);
 	setReadHead(0);
@@ -243,6 +361,13 @@ void WolfEngine::reset() {
 	setMode(modeDefault);
 
 	rowBuffer[readHead] = seed;
+
+	worldBuffer = {};
+	if (worldSize > 8)
+		seedWorld(worldBuffer[readHead], seed);
+
+	previousRow = {};
+
 	updateDisplay(false);
 }
 
@@ -252,21 +377,65 @@ void WolfEngine::setBufferFrame(uint64_t newFrame, int index,
 
 	if (setDisplayMatrix)
 		internalDisplayMatrix = newFrame;
-	else if ((index >= 0) && (index < MAX_SEQUENCE_LENGTH))
+	else if ((index >= 0) && (index < static_cast<int>(rowBuffer.size())))
 		rowBuffer[index] = static_cast<uint8_t>(newFrame);
 }
 
+void WolfEngine::setBufferFrames(const uint64_t* frames, size_t count) {
+	count = std::min(count, rowBuffer.size());
+	for (size_t i = 0; i < count; i++)
+		rowBuffer[i] = static_cast<uint8_t>(frames[i]);
+}
+
 void WolfEngine::onRuleChange() {
-	rule = static_cast<uint8_t>(rack::clamp(ruleSelect + ruleCv, 0, UINT8_MAX));
+	// Rules are only compiled when the active rule changes
+	int newRule = rack::clamp(ruleSelect + ruleCv, 0, NUM_RULES - 1);
+	if (newRule == rule)
+		return;
+
+	rule = newRule;
+	compileRule();
+}
+
+void WolfEngine::compileRule() {
+	// Every rule becomes a truth table over the neighbourhood,
+	// radius 2 tables are indexed by (ll l c r rr), MSB first
+	if (rule < NUM_ELEMENTARY_RULES) {
+		ruleTable = static_cast<uint32_t>(rule);
+		ruleRadius = 1;
+		return;
+	}
+
+	const ExtendedRule& extended = extendedRule[rule - NUM_ELEMENTARY_RULES];
+	ruleRadius = 2;
+
+	if (extended.type == RADIUS_2) {
+		ruleTable = extended.value;
+		return;
+	}
+
+	ruleTable = 0;
+	for (uint32_t n = 0; n < 32; n++) {
+		uint32_t bit = 0;
+		if (extended.type == TOTALISTIC) {
+			bit = (extended.value >> __builtin_popcount(n)) & 1;
+		}
+		else if (extended.type == OUTER_TOTALISTIC) {
+			int outer = __builtin_popcount(n & 0x1BU);
+			int center = (n >> 2) & 1;
+			bit = (extended.value >> (outer + (5 * center))) & 1;
+		}
+		ruleTable |= bit << n;
+	}
 }
 
 void WolfEngine::setRuleSelect(int newRule) {
-	ruleSelect = rack::clamp(newRule, 0, UINT8_MAX);
+	ruleSelect = rack::clamp(newRule, 0, NUM_RULES - 1);
 	onRuleChange();
 }
 
 void WolfEngine::setRuleCv(float newRuleCv) {
-	ruleCv = static_cast<int>(std::round(newRuleCv * 256));
+	ruleCv = static_cast<int>(std::round(newRuleCv * NUM_RULES));
 	onRuleChange();
 }
 
@@ -301,12 +470,19 @@ uint64_t WolfEngine::getBufferFrame(int index,
 		return displayMatrix;
 	else if (getDisplayMatrixSave)
 		return internalDisplayMatrix;
-	else if ((index >= 0) && (index < MAX_SEQUENCE_LENGTH))
+	else if ((index >= 0) && (index < static_cast<int>(rowBuffer.size())))
 		return static_cast<uint64_t>(rowBuffer[index]);
 	else
 		return 0;
 }
 
+void WolfEngine::getBufferFrames(uint64_t* frames, size_t count) {
+	size_t stored = std::min(count, rowBuffer.size());
+	for (size_t i = 0; i < stored; i++)
+		frames[i] = rowBuffer[i];
+	std::fill(frames + stored, frames + count, 0);
+}
+
 int WolfEngine::getRuleSelect() {
 	return ruleSelect;
 }
@@ -319,13 +495,217 @@ int WolfEngine::getMode() {
 	return modeIndex;
 }
 
+// Wide world
+void WolfEngine::setWorldSize(int newWorldSizeIndex) {
+	newWorldSizeIndex = rack::clamp(newWorldSizeIndex, 0, NUM_WORLD_SIZES - 1);
+	if (newWorldSizeIndex == worldSizeIndex)
+		return;
+
+	// Leaving a wide world keeps what was visible in the sequence buffer
+	if (worldSize > 8) {
+		for (int i = 0; i < MAX_SEQUENCE_LENGTH; i++)
+			rowBuffer[i] = getWindow(worldBuffer[i]);
+		previousRow = { getWindow(previousRow) };
+	}
+
+	worldSizeIndex = newWorldSizeIndex;
+	worldSize = worldSizes[worldSizeIndex];
+	worldWords = worldSize / 64;
+	setMaxLength((worldSize > 8) ? MAX_SEQUENCE_LENGTH : rowBuffer.size());
+
+	// Window starts centred, as with OFFSET and the view CV at default
+	viewX = (worldSize > 8) ? (worldSize / 2) : 0;
+
+	// Entering a wide world starts with the 8 cell rows in its window
+	worldBuffer = {};
+	if (worldSize > 8) {
+		for (int i = 0; i < MAX_SEQUENCE_LENGTH; i++)
+			setWindow(worldBuffer[i], rowBuffer[i]);
+
+		uint8_t previousWindow = static_cast<uint8_t>(previousRow[0]);
+		previousRow = {};
+		setWindow(previousRow, previousWindow);
+	}
+
+	updateDisplay(false);
+}
+
+int WolfEngine::getWorldSize() {
+	return worldSizeIndex;
+}
+
+void WolfEngine::setWorldWord(uint64_t newWord, int frame, int word) {
+	if ((frame >= 0) && (frame < MAX_SEQUENCE_LENGTH) && (word >= 0) && (word < worldWords))
+		worldBuffer[frame][word] = newWord;
+}
+
+uint64_t WolfEngine::getWorldWord(int frame, int word) {
+	if ((frame >= 0) && (frame < MAX_SEQUENCE_LENGTH) && (word >= 0) && (word < worldWords))
+		return worldBuffer[frame][word];
+	return 0;
+}
+
+void WolfEngine::setReversible(bool newReversible) {
+	if (newReversible == reversible)
+		return;
+
+	// Starts from the current row alone, as if the row before it was empty
+	reversible = newReversible;
+	previousRow = {};
+}
+
+bool WolfEngine::getReversible() {
+	return reversible;
+}
+
+void WolfEngine::setPreviousWord(uint64_t newWord, int word) {
+	if ((word >= 0) && (word < MAX_WORLD_WORDS))
+		previousRow[word] = newWord;
+}
+
+uint64_t WolfEngine::getPreviousWord(int word) {
+	if ((word >= 0) && (word < MAX_WORLD_WORDS))
+		return previousRow[word];
+	return 0;
+}
+
+void WolfEngine::setHistoryDepth(size_t depth) {
+	rowBuffer.resize(static_cast<size_t>(rack::clamp(static_cast<int>(depth), MAX_SEQUENCE_LENGTH, MAX_LONG_SEQUENCE_LENGTH)));
+	setMaxLength((worldSize > 8) ? MAX_SEQUENCE_LENGTH : rowBuffer.size());
+}
+
+void WolfEngine::requestHistoryDepth(size_t depth) {
+	rowBuffer.request(static_cast<size_t>(rack::clamp(static_cast<int>(depth), MAX_SEQUENCE_LENGTH, MAX_LONG_SEQUENCE_LENGTH)));
+}
+
+void WolfEngine::collectHistory() {
+	rowBuffer.collect();
+}
+
+uint8_t WolfEngine::getViewRow(size_t index) {
+	// Row as it is displayed, offset applied or the wide world window
+	if (worldSize > 8)
+		return getWindow(worldBuffer[index]);
+	return applyOffset(rowBuffer[index], offset);
+}
+
+uint8_t WolfEngine::getWindow(const WideRow& row) {
+	int word = viewX / 64;
+	int bit = viewX % 64;
+	uint64_t window = row[word] >> bit;
+	if (bit > 56)
+		window |= row[(word + 1) % worldWords] << (64 - bit);
+	return static_cast<uint8_t>(window & 0xFFULL);
+}
+
+void WolfEngine::setWindow(WideRow& row, uint8_t window) {
+	for (int i = 0; i < 8; i++) {
+		int cell = (viewX + i) % worldSize;
+		uint64_t mask = 1ULL << (cell % 64);
+		uint64_t& word = row[cell / 64];
+		word = ((window >> i) & 1) ? (word | mask) : (word & ~mask);
+	}
+}
+
+void WolfEngine::seedWorld(WideRow& row, uint8_t resetRow) {
+	// Random seed fills the whole world,
+	// other seeds are placed in the visible window of an empty world
+	row = {};
+
+	if (randSeed) {
+		for (int i = 0; i < worldWords; i++)
+			row[i] = rack::random::get<uint64_t>();
+	}
+	else {
+		setWindow(row, resetRow);
+	}
+}
+
+void WolfEngine::stepWorld(const WideRow& read, WideRow& write) {
+	// Whole word shifts carry neighbours across word boundaries,
+	// so the rule runs on 64 cells at a time
+	int last = worldWords - 1;
+
+	// Words beyond each end, clip leaves them empty
+	uint64_t leftEdge = 0;
+	uint64_t rightEdge = 0;
+	if (modeIndex == 1) {
+		// Wrap
+		leftEdge = read[0];
+		rightEdge = read[last];
+	}
+	else if (modeIndex == 2) {
+		// Random
+		leftEdge = rack::random::get<uint64_t>();
+		rightEdge = rack::random::get<uint64_t>();
+	}
+
+	for (int i = 0; i < worldWords; i++) {
+		uint64_t center = read[i];
+		uint64_t next = (i == last) ? leftEdge : read[i + 1];
+		uint64_t previous = (i == 0) ? rightEdge : read[i - 1];
+		uint64_t left = (center >> 1) | (next << 63);
+		uint64_t right = (center << 1) | (previous >> 63);
+
+		if (ruleRadius == 1) {
+			write[i] = applyRule<uint64_t>(left, center, right, ruleTable);
+		}
+		else {
+			uint64_t left2 = (center >> 2) | (next << 62);
+			uint64_t right2 = (center << 2) | (previous >> 62);
+			write[i] = applyRule2<uint64_t>(left2, left, center, right, right2, ruleTable);
+		}
+	}
+}
+
+uint8_t WolfEngine::stepRow(uint8_t readRow) {
+	// One Dimensional Cellular Automata
+	uint8_t writeRow = 0;
+
+	// Clip
+	uint8_t left = readRow >> 1;
+	uint8_t right = readRow << 1;
+
+	if (modeIndex == 1) {
+		// Wrap
+		left = (readRow >> 1) | (readRow << 7);
+		right = (readRow << 1) | (readRow >> 7);
+	}
+	else if (modeIndex == 2) {
+		// Random
+		left |= rack::random::get<bool>() << 7;
+		right |= rack::random::get<bool>();
+	}
+
+	if (ruleRadius == 1) {
+		writeRow = applyRule<uint8_t>(left, readRow, right, ruleTable);
+	}
+	else {
+		// Second neighbours, sharing the nearest edge cell with left and right
+		uint8_t left2 = readRow >> 2;
+		uint8_t right2 = readRow << 2;
+
+		if (modeIndex == 1) {
+			left2 = (readRow >> 2) | (readRow << 6);
+			right2 = (readRow << 2) | (readRow >> 6);
+		}
+		else if (modeIndex == 2) {
+			left2 |= ((left >> 7) << 6) | (rack::random::get<bool>() << 7);
+			right2 |= ((right & 1) << 1) | rack::random::get<bool>();
+		}
+
+		writeRow = applyRule2<uint8_t>(left2, left, readRow, right, right2, ruleTable);
+	}
+	return writeRow;
+}
+
 // UI getters
 void WolfEngine::getRuleActiveLabel(char out[5]) {
-	snprintf(out, 5, "%4d", rule);
+	getRuleLabel(rule, out);
 }
 
 void WolfEngine::getRuleSelectLabel(char out[5]) {
-	snprintf(out, 5, "%4d", ruleSelect);
+	getRuleLabel(ruleSelect, out);
 }
 
 void WolfEngine::getSeedLabel(char out[5]) {
@@ -334,4 +714,12 @@ void WolfEngine::getSeedLabel(char out[5]) {
 
 void WolfEngine::getModeLabel(char out[5]) {
 	memcpy(out, modeLabel[modeIndex], 5);
+}
+
+// Helpers
+void WolfEngine::getRuleLabel(int index, char out[5]) {
+	if (index < NUM_ELEMENTARY_RULES)
+		snprintf(out, 5, "%4d", rack::clamp(index, 0, NUM_ELEMENTARY_RULES - 1));
+	else
+		memcpy(out, extendedRule[index - NUM_ELEMENTARY_RULES].label, 5);
 }
\ No newline at end of file
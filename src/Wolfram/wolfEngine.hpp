@@ -8,24 +8,25 @@
 
 #pragma once
 #include "algoEngine.hpp"
+#include <vector>
 
-class WolfEngine : public AlgoEngine {
+class WolfEngine final : public AlgoEngine {
 public:
 	WolfEngine();
 
+	static constexpr const char* menuName = "Wolf";
+
 	void updateDisplay(bool advance, size_t length = 8) override;
 	void updateMenuParams(const EngineMenuParams& p) override;
 
-	void process(const EngineCoreParams& p,
-		float* xOut, float* yOut, 
-		bool* xPulse, bool* yPulse, 
-		float* modeLED) override;
+	void process(const EngineCoreParams& p, EngineOutput& out) override;
 
 	void reset() override;
 	
 	// Save setters
 	void setBufferFrame(uint64_t newFrame, int index, 
 		bool setDisplayMatrix=false) override;
+	void setBufferFrames(const uint64_t* frames, size_t count) override;
 
 	void setRuleSelect(int newRule) override;
 	void setRuleCv(float newRuleCv) override;
@@ -36,11 +37,35 @@ public:
 	uint64_t getBufferFrame(int index, 
 		bool getDisplayMatrix = false, 
 		bool getDisplayMatrixSave = false) override;
+	void getBufferFrames(uint64_t* frames, size_t count) override;
 
 	int getRuleSelect() override;
 	int getSeed() override;
 	int getMode() override;
 
+	// Wide world, up to 256 cells seen through the 8 cell display
+	static constexpr int NUM_WORLD_SIZES = 4;
+	static constexpr int MAX_WORLD_WORDS = 4;
+	static constexpr std::array<int, NUM_WORLD_SIZES> worldSizes{ 8, 64, 128, 256 };
+
+	void setWorldSize(int newWorldSizeIndex);
+	int getWorldSize();
+	void setWorldWord(uint64_t newWord, int frame, int word);
+	uint64_t getWorldWord(int frame, int word);
+
+	// Reversible, second order rule
+	void setReversible(bool newReversible);
+	bool getReversible();
+	void setPreviousWord(uint64_t newWord, int word);
+	uint64_t getPreviousWord(int word);
+
+	// History depth, frames kept by the 8 cell world's sequence buffer.
+	// setHistoryDepth() resizes at once, outside the audio thread,
+	// requestHistoryDepth() and collectHistory() are for the UI thread
+	void setHistoryDepth(size_t depth);
+	void requestHistoryDepth(size_t depth);
+	void collectHistory();
+
 	// UI getters
 	void getRuleActiveLabel(char out[5]) override;
 	void getRuleSelectLabel(char out[5]) override;
@@ -48,18 +73,55 @@ public:
 	void getModeLabel(char out[5]) override;
 
 protected:
-	std::array<uint8_t, MAX_SEQUENCE_LENGTH> rowBuffer{};
+	// Up to MAX_LONG_SEQUENCE_LENGTH on the 8 cell world, wide worlds loop 64 frames
+	HistoryBuffer<uint8_t> rowBuffer{ MAX_SEQUENCE_LENGTH };
 	uint64_t internalDisplayMatrix = 0;
 
+	// 64 cells per uint64_t, cell 0 is bit 0 of the first word
+	using WideRow = std::array<uint64_t, MAX_WORLD_WORDS>;
+	std::array<WideRow, MAX_SEQUENCE_LENGTH> worldBuffer{};
+	int worldSizeIndex = 0;
+	int worldSize = 8;
+	int worldWords = 0;
+	int viewX = 0;
+
+	// Second order rule, next = rule(current) ^ previous, exact backwards
+	// with fixed edges, RAND edges are not reversible.
+	// Holds the row before the current one, the first word for 8 cell worlds
+	bool reversible = false;
+	WideRow previousRow{};
+
 	static constexpr int NUM_MODES = 3;
 	static const char modeLabel[NUM_MODES][5];
 	static constexpr int modeDefault = 1;
 	int modeIndex = modeDefault;
 
-	static constexpr uint8_t ruleDefault = 30;
+	// Rules 0 - 255 are elementary, then a curated list of
+	// radius 2, totalistic and outer totalistic rules
+	enum RuleType {
+		ELEMENTARY,
+		RADIUS_2,			// 32-bit rule number, ll l c r rr
+		TOTALISTIC,			// Code bit per sum of the 5 cells
+		OUTER_TOTALISTIC	// Bits 0 - 4 sum of the 4 outer cells, dead centre, 5 - 9 alive
+	};
+
+	struct ExtendedRule {
+		char label[5];
+		RuleType type;
+		uint32_t value;
+	};
+
+	static constexpr int NUM_ELEMENTARY_RULES = 256;
+	static constexpr int NUM_EXTENDED_RULES = 21;
+	static constexpr int NUM_RULES = NUM_ELEMENTARY_RULES + NUM_EXTENDED_RULES;
+	static const std::array<ExtendedRule, NUM_EXTENDED_RULES> extendedRule;
+	static constexpr int ruleDefault = 30;
 	int ruleSelect = ruleDefault;
 	int ruleCv = 0;
-	uint8_t rule = 0;
+	int rule = -1;
+	// Active rule compiled to a truth table, indexed by the neighbourhood
+	uint32_t ruleTable = 0;
+	int ruleRadius = 1;
 
 	static constexpr int NUM_SEEDS = 256;
 	static constexpr uint8_t seedDefault = 0x08;
@@ -75,5 +137,51 @@ protected:
 	static constexpr  float modeScaler = 1.f / (static_cast<float>(NUM_MODES) - 1.f);
 
 	void inject(int inject, bool sync) override;
+	void renderPlayheads(const EngineCoreParams& p);
 	void onRuleChange() override;
+
+	// Wide world
+	uint8_t getViewRow(size_t index);
+	uint8_t getWindow(const WideRow& row);
+	void setWindow(WideRow& row, uint8_t window);
+	void seedWorld(WideRow& row, uint8_t resetRow);
+	void stepWorld(const WideRow& read, WideRow& write);
+	uint8_t stepRow(uint8_t readRow);
+
+	void compileRule();
+	void getRuleLabel(int index, char out[5]);
+
+	// Helpers
+	template <typename T>
+	static inline T applyRule(T left, T center, T right, uint32_t ruleValue) {
+		// Bit-sliced rule, the neighbourhood selects a rule bit
+		// for every cell at once through a mux tree
+		std::array<T, 8> level{};
+		for (int k = 0; k < 8; k++)
+			level[k] = static_cast<T>(((ruleValue >> k) & 1) ? ~T(0) : T(0));
+
+		for (int k = 0; k < 4; k++)
+			level[k] = mux<T>(right, level[2 * k], level[(2 * k) + 1]);
+		for (int k = 0; k < 2; k++)
+			level[k] = mux<T>(center, level[2 * k], level[(2 * k) + 1]);
+		return mux<T>(left, level[0], level[1]);
+	}
+
+	template <typename T>
+	static inline T applyRule2(T left2, T left, T center, T right, T right2, uint32_t ruleValue) {
+		// Radius 2 version, 32 leaves
+		std::array<T, 32> level{};
+		for (int k = 0; k < 32; k++)
+			level[k] = static_cast<T>(((ruleValue >> k) & 1) ? ~T(0) : T(0));
+
+		for (int k = 0; k < 16; k++)
+			level[k] = mux<T>(right2, level[2 * k], level[(2 * k) + 1]);
+		for (int k = 0; k < 8; k++)
+			level[k] = mux<T>(right, level[2 * k], level[(2 * k) + 1]);
+		for (int k = 0; k < 4; k++)
+			level[k] = mux<T>(center, level[2 * k], level[(2 * k) + 1]);
+		for (int k = 0; k < 2; k++)
+			level[k] = mux<T>(left, level[2 * k], level[(2 * k) + 1]);
+		return mux<T>(left2, level[0], level[1]);
+	}
 };
\ No newline at end of file
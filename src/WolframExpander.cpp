@@ -0,0 +1,158 @@
+// WolframExpander.cpp
+// Part of the Modular Mooch Wolfram module (VCV Rack)
+//
+// GitHub: https://github.com/WesDaMooch/Modular-Mooch-VCV
+//
+// Copyright (c) 2026 Wesley Lawrence Leggo-Morrell
+// License: GPL-3.0-or-later
+//
+// Exposes the whole display matrix of a Wolfram placed to its left.
+// Rows and columns are numbered from the X and Y outputs,
+// row 1 is the bottom row and column 1 the right column.
+// CV inputs are sent back to Wolfram.
+
+#include "plugin.hpp"
+#include "Wolfram/expanderMessage.hpp"
+#include <array>
+
+struct WolframExpander : Module {
+	enum ParamId {
+		ROW_PARAM,
+		COLUMN_PARAM,
+		PARAMS_LEN
+	};
+	enum InputId {
+		VIEW_CV_INPUT,
+		DIRECTION_CV_INPUT,
+		STAMP_X_CV_INPUT,
+		STAMP_Y_CV_INPUT,
+		SCRUB_CV_INPUT,
+		TRANSFORM_CV_INPUT,
+		INPUTS_LEN
+	};
+	enum OutputId {
+		ROWS_OUTPUT,
+		COLUMNS_OUTPUT,
+		GATES_OUTPUT,
+		POPULATION_OUTPUT,
+		OUTPUTS_LEN
+	};
+	enum LightId {
+		LIGHTS_LEN
+	};
+
+	static constexpr float voltageScaler = 10.f / UINT8_MAX;
+	static constexpr float populationScaler = 10.f / 8.f;
+
+	std::array<WolframToExpanderMessage, 2> leftMessages{};
+
+	WolframExpander() {
+		config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
+		configParam(ROW_PARAM, 0.f, 7.f, 0.f, "Gate row", "", 0.f, 1.f, 1.f);
+		paramQuantities[ROW_PARAM]->snapEnabled = true;
+		configParam(COLUMN_PARAM, 0.f, 7.f, 0.f, "Gate column", "", 0.f, 1.f, 1.f);
+		paramQuantities[COLUMN_PARAM]->snapEnabled = true;
+		configInput(VIEW_CV_INPUT, "World view CV");
+		configInput(DIRECTION_CV_INPUT, "Direction CV, high runs reversible Wolf backwards");
+		configInput(STAMP_X_CV_INPUT, "Life stamp X CV");
+		configInput(STAMP_Y_CV_INPUT, "Life stamp Y CV");
+		configInput(SCRUB_CV_INPUT, "Scrub CV, 0 - 10V looks back through the loop");
+		configInput(TRANSFORM_CV_INPUT, "Display transform CV, 0 - 10V steps through the transforms");
+		configOutput(ROWS_OUTPUT, "Rows (8 channel)");
+		configOutput(COLUMNS_OUTPUT, "Columns (8 channel)");
+		configOutput(GATES_OUTPUT, "Row & column gates (16 channel)");
+		configOutput(POPULATION_OUTPUT, "Row populations (8 channel)");
+
+		leftExpander.producerMessage = &leftMessages[0];
+		leftExpander.consumerMessage = &leftMessages[1];
+	}
+
+	// Helpers
+	static inline uint8_t getColumn(uint64_t matrix, int column) {
+		// Gather one bit from each row with a single multiply,
+		// same as the Wolf Y output
+		uint64_t columnBits = (matrix >> column) & 0x0101010101010101ULL;
+		return static_cast<uint8_t>((columnBits * 0x8040201008040201ULL) >> 56);
+	}
+
+	static inline uint64_t getRowPopulations(uint64_t matrix) {
+		// Population of all eight rows at once, one count per byte
+		matrix = matrix - ((matrix >> 1) & 0x5555555555555555ULL);
+		matrix = (matrix & 0x3333333333333333ULL) + ((matrix >> 2) & 0x3333333333333333ULL);
+		return (matrix + (matrix >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+	}
+
+	void process(const ProcessArgs& args) override {
+		Module* wolfram = leftExpander.module;
+		bool connected = wolfram && (wolfram->model == modelWolfram);
+		uint64_t matrix = 0;
+		if (connected) {
+			matrix = static_cast<WolframToExpanderMessage*>(leftExpander.consumerMessage)->matrix;
+
+			auto* message = static_cast<ExpanderToWolframMessage*>(wolfram->rightExpander.producerMessage);
+			message->viewOffset = rack::clamp(inputs[VIEW_CV_INPUT].getVoltage() * 0.1f, -1.f, 1.f);
+			message->reverse = inputs[DIRECTION_CV_INPUT].getVoltage() >= 1.f;
+			message->stampX = rack::clamp(inputs[STAMP_X_CV_INPUT].getVoltage() * 0.1f, -1.f, 1.f);
+			message->stampY = rack::clamp(inputs[STAMP_Y_CV_INPUT].getVoltage() * 0.1f, -1.f, 1.f);
+			message->scrub = rack::clamp(inputs[SCRUB_CV_INPUT].getVoltage() * 0.1f, 0.f, 1.f);
+			message->transform = rack::clamp(inputs[TRANSFORM_CV_INPUT].getVoltage() * 0.1f, 0.f, 1.f);
+			wolfram->rightExpander.requestMessageFlip();
+		}
+
+		int channels = connected ? 8 : 0;
+		outputs[ROWS_OUTPUT].setChannels(channels);
+		outputs[COLUMNS_OUTPUT].setChannels(channels);
+		outputs[GATES_OUTPUT].setChannels(connected ? 16 : 0);
+		outputs[POPULATION_OUTPUT].setChannels(channels);
+
+		if (!connected)
+			return;
+
+		int gateRow = static_cast<int>(params[ROW_PARAM].getValue());
+		int gateColumn = static_cast<int>(params[COLUMN_PARAM].getValue());
+		uint8_t gateRowBits = (matrix >> (gateRow * 8)) & 0xFFULL;
+		uint8_t gateColumnBits = getColumn(matrix, gateColumn);
+		uint64_t populations = getRowPopulations(matrix);
+
+		for (int i = 0; i < 8; i++) {
+			uint8_t row = (matrix >> (i * 8)) & 0xFFULL;
+			uint8_t column = getColumn(matrix, i);
+			uint8_t population = (populations >> (i * 8)) & 0xFFULL;
+
+			outputs[ROWS_OUTPUT].setVoltage(row * voltageScaler, i);
+			outputs[COLUMNS_OUTPUT].setVoltage(column * voltageScaler, i);
+			outputs[POPULATION_OUTPUT].setVoltage(population * populationScaler, i);
+
+			outputs[GATES_OUTPUT].setVoltage(((gateRowBits >> i) & 1) ? 10.f : 0.f, i);
+			outputs[GATES_OUTPUT].setVoltage(((gateColumnBits >> (7 - i)) & 1) ? 10.f : 0.f, i + 8);
+		}
+	}
+};
+
+struct WolframExpanderWidget : ModuleWidget {
+	WolframExpanderWidget(WolframExpander* module) {
+		setModule(module);
+		setPanel(createPanel(asset::plugin(pluginInstance, "res/panels/wolframExpander.svg")));
+
+		// Srews
+		addChild(createWidget<ThemedScrew>(Vec(RACK_GRID_WIDTH, 0)));
+		addChild(createWidget<ThemedScrew>(Vec(RACK_GRID_WIDTH, RACK_GRID_HEIGHT - RACK_GRID_WIDTH)));
+		// Dials
+		addParam(createParamCentered<Trimpot>(mm2px(Vec(7.62f, 22.14f)), module, WolframExpander::ROW_PARAM));
+		addParam(createParamCentered<Trimpot>(mm2px(Vec(22.86f, 22.14f)), module, WolframExpander::COLUMN_PARAM));
+		// Inputs
+		addInput(createInputCentered<PJ301MPort>(mm2px(Vec(7.62f, 46.0f)), module, WolframExpander::VIEW_CV_INPUT));
+		addInput(createInputCentered<PJ301MPort>(mm2px(Vec(22.86f, 46.0f)), module, WolframExpander::DIRECTION_CV_INPUT));
+		addInput(createInputCentered<PJ301MPort>(mm2px(Vec(7.62f, 61.0f)), module, WolframExpander::STAMP_X_CV_INPUT));
+		addInput(createInputCentered<PJ301MPort>(mm2px(Vec(22.86f, 61.0f)), module, WolframExpander::STAMP_Y_CV_INPUT));
+		addInput(createInputCentered<PJ301MPort>(mm2px(Vec(7.62f, 76.0f)), module, WolframExpander::SCRUB_CV_INPUT));
+		addInput(createInputCentered<PJ301MPort>(mm2px(Vec(22.86f, 76.0f)), module, WolframExpander::TRANSFORM_CV_INPUT));
+		// Outputs
+		addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(7.62f, 99.852f)), module, WolframExpander::ROWS_OUTPUT));
+		addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(22.86f, 99.852f)), module, WolframExpander::COLUMNS_OUTPUT));
+		addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(7.62f, 114.852f)), module, WolframExpander::GATES_OUTPUT));
+		addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(22.86f, 114.852f)), module, WolframExpander::POPULATION_OUTPUT));
+	}
+};
+
+Model* modelWolframExpander = createModel<WolframExpander, WolframExpanderWidget>("WolframExpander");
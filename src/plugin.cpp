@@ -1,9 +1,12 @@
 #include "plugin.hpp"
+#include "Wolfram/lifeRule.hpp"
 
 Plugin* pluginInstance;
 
 void init(Plugin* p) {
 	pluginInstance = p;
+	loadUserLifeRules();
 
 	p->addModel(modelWolfram);
+	p->addModel(modelWolframExpander);
 }